@@ -0,0 +1,66 @@
+#include "Arena.h"
+
+/**
+ * @brief Construtor da classe Arena.
+ * Complexidade: O(1).
+ */
+Arena::Arena() {
+    _resources.push_back(std::make_unique<std::pmr::monotonic_buffer_resource>());
+}
+
+/**
+ * @brief Garante que as próximas alocações, até ao número de bytes indicado, são feitas num único bloco.
+ * Complexidade: O(1).
+ * @param bytes - Número de bytes que vão ser alocados.
+ */
+void Arena::reserve(size_t bytes) {
+    if (bytes == 0) return;
+    _resources.push_back(std::make_unique<std::pmr::monotonic_buffer_resource>(bytes));
+    _reserved += bytes;
+}
+
+/**
+ * @brief Permite obter o número de bytes alocados na arena.
+ * Complexidade: O(1).
+ * @return Número de bytes.
+ */
+size_t Arena::getUsed() const {
+    return _used;
+}
+
+/**
+ * @brief Permite obter o número de bytes reservados com reserve().
+ * Complexidade: O(1).
+ * @return Número de bytes.
+ */
+size_t Arena::getReserved() const {
+    return _reserved;
+}
+
+/**
+ * @brief Aloca memória no último recurso monótono.
+ * Complexidade: O(1).
+ * @param bytes - Número de bytes.
+ * @param alignment - Alinhamento.
+ * @return Endereço da memória alocada.
+ */
+void *Arena::do_allocate(size_t bytes, size_t alignment) {
+    _used += bytes;
+    return _resources.back()->allocate(bytes, alignment);
+}
+
+/**
+ * @brief Ignora a libertação: a memória só é devolvida quando a arena é destruída.
+ * Complexidade: O(1).
+ */
+void Arena::do_deallocate(void *, size_t, size_t) {}
+
+/**
+ * @brief Duas arenas só são iguais se forem o mesmo objeto.
+ * Complexidade: O(1).
+ * @param other - Recurso a comparar.
+ * @return Verdadeiro se forem o mesmo recurso.
+ */
+bool Arena::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
@@ -0,0 +1,45 @@
+#ifndef PROJECT_1_SCHEDULE_ARENA_H
+#define PROJECT_1_SCHEDULE_ARENA_H
+
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief Recurso de memória monótono usado pelas estruturas criadas ao carregar os ficheiros (nós dos mapas de
+ * estudantes e de turmas e vetores de turmas e de aulas). As libertações individuais são ignoradas e toda a memória é
+ * devolvida de uma só vez quando o recurso é destruído.
+ * Antes de carregar um ficheiro, reserve() indica quantos bytes vão ser necessários, de forma a que o carregamento
+ * ocupe um único bloco.
+ */
+
+class Arena : public std::pmr::memory_resource {
+public:
+
+    Arena();
+
+    void reserve(size_t bytes);
+
+    [[nodiscard]] size_t getUsed() const;
+
+    [[nodiscard]] size_t getReserved() const;
+
+private:
+    /** @brief Recursos monótonos, um por cada reserva; as novas alocações são feitas no último. */
+    std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> _resources;
+    /** @brief Número de bytes alocados. */
+    size_t _used = 0;
+    /** @brief Número de bytes reservados. */
+    size_t _reserved = 0;
+
+    void *do_allocate(size_t bytes, size_t alignment) override;
+
+    void do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+};
+
+
+#endif //PROJECT_1_SCHEDULE_ARENA_H
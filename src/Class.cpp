@@ -1,12 +1,40 @@
 #include "Class.h"
+#include "MemoryUsage.h"
+
+/**
+ * @brief Construtor da classe Class sem aulas, com o alocador indicado.
+ * Complexidade: O(1).
+ * @param allocator - Alocador do vetor de aulas.
+ */
+Class::Class(const allocator_type &allocator) : _lessons(allocator) {}
 
 /**
  * @brief Construtor da classe Class.
  * Complexidade: O(1).
  * @param ucClass - Turma à qual as informações remetem.
- * @param lessons - Conjunto de aulas da turma.
+ * @param allocator - Alocador do vetor de aulas.
+ */
+Class::Class(UCSpecificClass ucClass, const allocator_type &allocator) : _ucClass(std::move(ucClass)), _lessons(allocator) {}
+
+/**
+ * @brief Construtor de cópia da classe Class, com o alocador indicado.
+ * Complexidade: O(N + M), sendo N o número de aulas e M o número de alunos.
+ * @param other - Turma a copiar.
+ * @param allocator - Alocador do vetor de aulas.
+ */
+Class::Class(const Class &other, const allocator_type &allocator)
+        : _ucClass(other._ucClass), _lessons(other._lessons, allocator), _studentsIDs(other._studentsIDs),
+          _capacity(other._capacity) {}
+
+/**
+ * @brief Construtor de movimento da classe Class, com o alocador indicado.
+ * Complexidade: O(1) se os alocadores forem iguais, O(N) caso contrário.
+ * @param other - Turma a mover.
+ * @param allocator - Alocador do vetor de aulas.
  */
-Class::Class(UCSpecificClass ucClass, const std::vector<Lesson> &lessons) : _ucClass(std::move(ucClass)), _lessons(lessons) {}
+Class::Class(Class &&other, const allocator_type &allocator)
+        : _ucClass(std::move(other._ucClass)), _lessons(std::move(other._lessons), allocator),
+          _studentsIDs(std::move(other._studentsIDs)), _capacity(other._capacity) {}
 
 /**
  * @brief Permite obter a turma à qual as informações remetem.
@@ -22,10 +50,19 @@ const UCSpecificClass &Class::getUcClass() const {
  * Complexidade: O(1).
  * @return Vetor que representa o conjunto de aulas da turma.
  */
-const std::vector<Lesson> &Class::getLessons() const {
+const std::pmr::vector<Lesson> &Class::getLessons() const {
     return _lessons;
 }
 
+/**
+ * @brief Reserva espaço para o número de aulas indicado, para que o vetor não tenha de crescer durante o carregamento.
+ * Complexidade: O(N).
+ * @param n - Número de aulas.
+ */
+void Class::reserveLessons(size_t n) {
+    _lessons.reserve(n);
+}
+
 /**
  * @brief Permite adicionar uma aula ao conjunto de aulas da turma.
  * Complexidade: O(1).
@@ -37,7 +74,7 @@ void Class::addLesson(const Lesson &lesson) {
 
 /**
  * @brief Permite adicionar um aluno à turma.
- * Complexidade: O(1).
+ * Complexidade: O(N).
  * @param studentID - Id do aluno a adicionar.
  */
 void Class::addStudent(unsigned int studentID) {
@@ -46,7 +83,7 @@ void Class::addStudent(unsigned int studentID) {
 
 /**
  * @brief Permite remover um aluno da turma.
- * Complexidade: O(1).
+ * Complexidade: O(N).
  * @param studentID - Id do aluno a remover.
  */
 void Class::removeStudent(unsigned int studentID) {
@@ -58,12 +95,59 @@ void Class::removeStudent(unsigned int studentID) {
  * Complexidade: O(1).
  * @return Conjunto de alunos da turma, tendo em conta os seus ids.
  */
-const std::set<unsigned int> &Class::getStudentsIDs() const {
+const Roster &Class::getStudentsIDs() const {
     return _studentsIDs;
 }
 
+/**
+ * @brief Permite obter a capacidade máxima da turma.
+ * Complexidade: O(1).
+ * @return Número máximo de alunos.
+ */
+unsigned int Class::getCapacity() const {
+    return _capacity;
+}
+
+/**
+ * @brief Permite alterar a capacidade máxima da turma.
+ * Complexidade: O(1).
+ * @param capacity - Número máximo de alunos.
+ */
+void Class::setCapacity(unsigned int capacity) {
+    _capacity = capacity;
+}
+
 /**
  * @brief Construtor default da classe Class.
  * Complexidade: O(1).
  */
 Class::Class() = default;
+
+/**
+ * @brief Estima a memória dinâmica ocupada pelo vetor de aulas da turma.
+ * Complexidade: O(N), sendo N o número de aulas.
+ * @return Número de bytes.
+ */
+size_t Class::lessonsMemoryUsage() const {
+    size_t bytes = MemoryUsage::vectorBuffer(_lessons);
+    for (const Lesson &lesson : _lessons) bytes += lesson.memoryUsage();
+    return bytes;
+}
+
+/**
+ * @brief Estima a memória dinâmica ocupada pelo conjunto de alunos da turma.
+ * Complexidade: O(1).
+ * @return Número de bytes.
+ */
+size_t Class::studentsMemoryUsage() const {
+    return _studentsIDs.memoryUsage();
+}
+
+/**
+ * @brief Estima a memória dinâmica ocupada pela turma (identificação, aulas e alunos).
+ * Complexidade: O(N), sendo N o número de aulas.
+ * @return Número de bytes.
+ */
+size_t Class::memoryUsage() const {
+    return _ucClass.memoryUsage() + lessonsMemoryUsage() + studentsMemoryUsage();
+}
@@ -3,25 +3,48 @@
 
 
 #include <list>
-#include <set>
+#include <memory_resource>
 #include "UCSpecificClass.h"
 #include "Lesson.h"
+#include "Roster.h"
 
 /**
  * @brief Classe que representa uma turma de uma unidade curricular específica.
  * Nesta, são armazenadas informações como a lista de aulas (horário) da turma e uma lista de estudantes que a compõe.
+ * O vetor de aulas usa o alocador indicado na construção (a arena do ScheduleManager, para as turmas carregadas).
  */
 
 class Class {
 public:
+    /** @brief Alocador do vetor de aulas. */
+    using allocator_type = std::pmr::polymorphic_allocator<Lesson>;
+
+    /** @brief Capacidade máxima de uma turma que não tenha outra indicada no ficheiro de capacidades. */
+    static const unsigned int DEFAULT_CAPACITY = 30;
 
     Class();
 
-    Class(UCSpecificClass ucClass, const std::vector <Lesson> &lessons);
+    explicit Class(const allocator_type &allocator);
+
+    explicit Class(UCSpecificClass ucClass, const allocator_type &allocator = {});
+
+    Class(const Class &other) = default;
+
+    Class(Class &&other) = default;
+
+    Class(const Class &other, const allocator_type &allocator);
+
+    Class(Class &&other, const allocator_type &allocator);
+
+    Class &operator=(const Class &other) = default;
+
+    Class &operator=(Class &&other) = default;
 
     [[nodiscard]] const UCSpecificClass &getUcClass() const;
 
-    [[nodiscard]] const std::vector <Lesson> &getLessons() const;
+    [[nodiscard]] const std::pmr::vector <Lesson> &getLessons() const;
+
+    void reserveLessons(size_t n);
 
     void addLesson(const Lesson &lesson);
 
@@ -29,15 +52,27 @@ public:
 
     void removeStudent(unsigned int studentID);
 
-    [[nodiscard]] const std::set <unsigned int> &getStudentsIDs() const;
+    [[nodiscard]] const Roster &getStudentsIDs() const;
+
+    [[nodiscard]] unsigned int getCapacity() const;
+
+    void setCapacity(unsigned int capacity);
+
+    [[nodiscard]] size_t lessonsMemoryUsage() const;
+
+    [[nodiscard]] size_t studentsMemoryUsage() const;
+
+    [[nodiscard]] size_t memoryUsage() const;
 
 private:
     /** @brief Turma à qual as informações remetem. */
     UCSpecificClass _ucClass;
     /** @brief Conjunto de aulas da turma. */
-    std::vector <Lesson> _lessons;
+    std::pmr::vector <Lesson> _lessons;
     /** @brief Lista de alunos da turma. */
-    std::set <unsigned int> _studentsIDs;
+    Roster _studentsIDs;
+    /** @brief Número máximo de alunos da turma. */
+    unsigned int _capacity = DEFAULT_CAPACITY;
 };
 
 
@@ -0,0 +1,169 @@
+#include "ClassRebalancer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+
+/**
+ * @brief Construtor da classe ClassRebalancer.
+ * Complexidade: O(1).
+ * @param classes - Turmas da unidade curricular.
+ * @param threshold - Desvio padrão máximo pretendido.
+ */
+ClassRebalancer::ClassRebalancer(std::vector<RebalanceClass> classes, double threshold)
+        : _classes(std::move(classes)), _threshold(threshold) {}
+
+/**
+ * @brief Adiciona um aluno da unidade curricular.
+ * Complexidade: O(1).
+ * @param current - Índice da turma atual do aluno.
+ * @param allowed - Índices das turmas para onde o aluno pode mudar sem sobreposições (a turma atual é ignorada).
+ * @return Índice do aluno.
+ */
+size_t ClassRebalancer::addStudent(uint32_t current, std::vector<uint32_t> allowed) {
+    _members.push_back({current, std::move(allowed)});
+    return _members.size() - 1;
+}
+
+/**
+ * @brief Calcula o desvio padrão do número de alunos de um conjunto de turmas, da mesma forma que o
+ * ScheduleManager (numerador em inteiros).
+ * Complexidade: O(T), sendo T o número de turmas.
+ * @param sizes - Número de alunos de cada turma.
+ * @return Desvio padrão.
+ */
+double ClassRebalancer::deviation(const std::vector<unsigned int> &sizes) {
+    if (sizes.empty()) return 0;
+    int64_t classes = sizes.size(), sum = 0, sumSquares = 0;
+    for (int64_t size: sizes) {
+        sum += size;
+        sumSquares += size * size;
+    }
+    return std::sqrt((double) (classes * sumSquares - sum * sum)) / (double) classes;
+}
+
+/**
+ * @brief Calcula o número de alunos que cada turma deve ter no fim, passando um aluno de cada vez da turma mais cheia
+ * para a turma menos cheia com vagas, até o desvio padrão ficar abaixo do limite.
+ * Complexidade: O(M * T), sendo M o número de passos e T o número de turmas.
+ * @return Número de alunos pretendido para cada turma.
+ */
+std::vector<unsigned int> ClassRebalancer::targetSizes() const {
+    std::vector<unsigned int> sizes;
+    for (const RebalanceClass &info: _classes) sizes.push_back(info.size);
+    while (deviation(sizes) > _threshold) {
+        size_t fullest = 0, emptiest = sizes.size();
+        for (size_t c = 0; c < sizes.size(); c++) {
+            if (sizes[c] > sizes[fullest]) fullest = c;
+            if (sizes[c] < _classes[c].capacity && (emptiest == sizes.size() || sizes[c] < sizes[emptiest])) {
+                emptiest = c;
+            }
+        }
+        if (emptiest == sizes.size() || sizes[fullest] < sizes[emptiest] + 2) break;
+        sizes[fullest]--;
+        sizes[emptiest]++;
+    }
+    return sizes;
+}
+
+/**
+ * @brief Calcula as mudanças de turma, com um fluxo de custo mínimo (caminhos mais curtos sucessivos).
+ * Se não for possível chegar aos tamanhos pretendidos, devolve as mudanças do maior fluxo encontrado, desde que
+ * diminuam o desvio padrão.
+ * Complexidade: O(F * V * E), sendo F o número de alunos a mudar, V o número de turmas e alunos e E o número de
+ * mudanças possíveis.
+ * @return Mudanças, pela ordem dos alunos.
+ */
+std::vector<RebalanceMove> ClassRebalancer::plan() const {
+    std::vector<unsigned int> targets = targetSizes();
+    const uint32_t source = 0, sink = 1, firstClass = 2, firstStudent = firstClass + _classes.size();
+    std::vector<Edge> edges;
+    std::vector<std::vector<uint32_t>> graph(firstStudent + _members.size());
+    bool needed = false;
+    for (uint32_t c = 0; c < _classes.size(); c++) {
+        int change = (int) targets[c] - (int) _classes[c].size;
+        if (change < 0) addEdge(edges, graph, source, firstClass + c, -change, 0);
+        if (change > 0) addEdge(edges, graph, firstClass + c, sink, change, 0);
+        needed |= change != 0;
+    }
+    if (!needed) return {};
+    for (uint32_t s = 0; s < _members.size(); s++) {
+        addEdge(edges, graph, firstClass + _members[s].current, firstStudent + s, 1, 0);
+        for (uint32_t c: _members[s].allowed) {
+            if (c != _members[s].current) addEdge(edges, graph, firstStudent + s, firstClass + c, 1, 1);
+        }
+    }
+    while (augment(edges, graph, source, sink));
+
+    std::vector<RebalanceMove> moves;
+    std::vector<unsigned int> before, sizes;
+    for (const RebalanceClass &info: _classes) before.push_back(info.size);
+    sizes = before;
+    for (uint32_t s = 0; s < _members.size(); s++) {
+        for (uint32_t e: graph[firstStudent + s]) {
+            if (e % 2 == 0 && edges[e].to >= firstClass && edges[e].capacity == 0) {
+                uint32_t to = edges[e].to - firstClass;
+                moves.push_back({s, _members[s].current, to});
+                sizes[_members[s].current]--;
+                sizes[to]++;
+            }
+        }
+    }
+    if (deviation(sizes) >= deviation(before)) return {};
+    return moves;
+}
+
+/**
+ * @brief Acrescenta uma aresta ao grafo de fluxo, juntamente com a aresta inversa (capacidade 0 e custo simétrico).
+ * Complexidade: O(1).
+ */
+void ClassRebalancer::addEdge(std::vector<Edge> &edges, std::vector<std::vector<uint32_t>> &graph, uint32_t from,
+                              uint32_t to, int capacity, int cost) {
+    graph[from].push_back(edges.size());
+    edges.push_back({to, capacity, cost});
+    graph[to].push_back(edges.size());
+    edges.push_back({from, 0, -cost});
+}
+
+/**
+ * @brief Procura o caminho de menor custo da origem ao destino no grafo residual (Bellman-Ford com fila) e envia por
+ * ele o maior fluxo possível.
+ * Complexidade: O(V * E), sendo V o número de nós e E o número de arestas.
+ * @return Verdadeiro se foi encontrado um caminho, falso caso contrário.
+ */
+bool ClassRebalancer::augment(std::vector<Edge> &edges, const std::vector<std::vector<uint32_t>> &graph,
+                              uint32_t source, uint32_t sink) {
+    const int infinity = std::numeric_limits<int>::max();
+    std::vector<int> distance(graph.size(), infinity);
+    std::vector<int64_t> through(graph.size(), -1);
+    std::vector<bool> queued(graph.size(), false);
+    std::deque<uint32_t> queue = {source};
+    distance[source] = 0;
+    while (!queue.empty()) {
+        uint32_t node = queue.front();
+        queue.pop_front();
+        queued[node] = false;
+        for (uint32_t e: graph[node]) {
+            const Edge &edge = edges[e];
+            if (edge.capacity == 0 || distance[node] + edge.cost >= distance[edge.to]) continue;
+            distance[edge.to] = distance[node] + edge.cost;
+            through[edge.to] = e;
+            if (!queued[edge.to]) {
+                queued[edge.to] = true;
+                queue.push_back(edge.to);
+            }
+        }
+    }
+    if (distance[sink] == infinity) return false;
+
+    int flow = infinity;
+    for (uint32_t node = sink; node != source; node = edges[through[node] ^ 1].to) {
+        flow = std::min(flow, edges[through[node]].capacity);
+    }
+    for (uint32_t node = sink; node != source; node = edges[through[node] ^ 1].to) {
+        edges[through[node]].capacity -= flow;
+        edges[through[node] ^ 1].capacity += flow;
+    }
+    return true;
+}
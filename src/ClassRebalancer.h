@@ -0,0 +1,91 @@
+#ifndef PROJECT_1_SCHEDULE_CLASSREBALANCER_H
+#define PROJECT_1_SCHEDULE_CLASSREBALANCER_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Turma de uma unidade curricular, com o número de alunos e a capacidade máxima.
+ */
+
+struct RebalanceClass {
+    /** @brief Identificador compacto da turma. */
+    uint32_t classId;
+    /** @brief Número de alunos inscritos na turma. */
+    unsigned int size;
+    /** @brief Capacidade máxima da turma. */
+    unsigned int capacity;
+};
+
+/**
+ * @brief Mudança de turma de um aluno, dentro da mesma unidade curricular.
+ */
+
+struct RebalanceMove {
+    /** @brief Índice do aluno (pela ordem de addStudent). */
+    uint32_t student;
+    /** @brief Índice da turma atual. */
+    uint32_t from;
+    /** @brief Índice da nova turma. */
+    uint32_t to;
+};
+
+/**
+ * @brief Calcula o menor conjunto de mudanças de turma que deixa o desvio padrão das turmas de uma unidade curricular
+ * abaixo de um limite, sem criar sobreposições nem exceder a capacidade das turmas.
+ * Primeiro são escolhidos os tamanhos finais das turmas, passando um aluno de cada vez da turma mais cheia para a menos
+ * cheia até o desvio ficar abaixo do limite (cada passo é o que mais diminui a soma dos quadrados). Depois as mudanças
+ * são obtidas por um fluxo de custo mínimo: a origem liga às turmas que perdem alunos, as turmas que ganham alunos
+ * ligam ao destino, cada turma liga aos seus alunos e cada aluno liga, com custo 1, às turmas para onde pode ir sem
+ * sobreposições. Um caminho pode passar por várias turmas (um aluno sai de A para B e outro de B para C), pelo que um
+ * aluno que não pode ir diretamente para a turma que precisa de alunos não impede o balanceamento.
+ */
+
+class ClassRebalancer {
+public:
+    ClassRebalancer(std::vector<RebalanceClass> classes, double threshold);
+
+    size_t addStudent(uint32_t current, std::vector<uint32_t> allowed);
+
+    [[nodiscard]] std::vector<RebalanceMove> plan() const;
+
+    [[nodiscard]] std::vector<unsigned int> targetSizes() const;
+
+    static double deviation(const std::vector<unsigned int> &sizes);
+
+private:
+    /**
+     * @brief Aresta do grafo de fluxo (a aresta inversa está na posição seguinte ou anterior, index ^ 1).
+     */
+    struct Edge {
+        uint32_t to;
+        int capacity;
+        int cost;
+    };
+
+    /**
+     * @brief Aluno da unidade curricular: a turma atual e as turmas para onde pode mudar.
+     */
+    struct Member {
+        uint32_t current;
+        std::vector<uint32_t> allowed;
+    };
+
+    /** @brief Turmas da unidade curricular. */
+    std::vector<RebalanceClass> _classes;
+    /** @brief Alunos da unidade curricular, pela ordem em que foram adicionados. */
+    std::vector<Member> _members;
+    /** @brief Desvio padrão máximo pretendido. */
+    double _threshold;
+
+    static void addEdge(std::vector<Edge> &edges, std::vector<std::vector<uint32_t>> &graph, uint32_t from,
+                        uint32_t to, int capacity, int cost);
+
+    static bool augment(std::vector<Edge> &edges, const std::vector<std::vector<uint32_t>> &graph, uint32_t source,
+                        uint32_t sink);
+};
+
+
+#endif //PROJECT_1_SCHEDULE_CLASSREBALANCER_H
@@ -0,0 +1,146 @@
+#include "CoEnrollmentMatrix.h"
+#include "MemoryUsage.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+/**
+ * @brief Esvazia a matriz e os conjuntos de alunos, preparando-os para 'students' alunos e 'ucs' UCs.
+ * Complexidade: O(U * (U + N / 64)), sendo U o número de UCs e N o número de alunos.
+ * @param students - Número de alunos.
+ * @param ucs - Número de UCs.
+ */
+void CoEnrollmentMatrix::reset(size_t students, size_t ucs) {
+    _students = students;
+    _ucs = ucs;
+    _words = (students + 63) / 64;
+    _bits.assign(_ucs * _words, 0);
+    _matrix.assign(_ucs * _ucs, 0);
+}
+
+/**
+ * @brief Marca um aluno como inscrito numa UC, sem atualizar a matriz (usado antes de compute()).
+ * Complexidade: O(1).
+ * @param student - Posição do aluno.
+ * @param ucId - Identificador da UC.
+ */
+void CoEnrollmentMatrix::set(uint32_t student, uint16_t ucId) {
+    if (student >= _students || ucId >= _ucs) return;
+    _bits[ucId * _words + student / 64] |= uint64_t(1) << (student % 64);
+}
+
+/**
+ * @brief Calcula todas as células da matriz a partir dos conjuntos de alunos. Cada thread calcula linhas inteiras (a
+ * parte acima da diagonal e a célula simétrica), pelo que as threads nunca escrevem na mesma célula.
+ * Complexidade: O(U^2 * W / T), sendo U o número de UCs, W o número de palavras em que duas UCs têm alunos e T o
+ * número de threads.
+ * @param threads - Número de threads (0 para usar todas as do processador).
+ */
+void CoEnrollmentMatrix::compute(unsigned int threads) {
+    std::vector<size_t> first(_ucs, _words), last(_ucs, 0);
+    for (size_t uc = 0; uc < _ucs; uc++) {
+        const uint64_t *row = _bits.data() + uc * _words;
+        for (size_t w = 0; w < _words; w++) {
+            if (row[w] == 0) continue;
+            first[uc] = std::min(first[uc], w);
+            last[uc] = w + 1;
+        }
+    }
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max<size_t>(1, std::min<size_t>(threads, _ucs));
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t a = next++; a < _ucs; a = next++) {
+            const uint64_t *rowA = _bits.data() + a * _words;
+            for (size_t b = a; b < _ucs; b++) {
+                const uint64_t *rowB = _bits.data() + b * _words;
+                uint32_t count = 0;
+                for (size_t w = std::max(first[a], first[b]), end = std::min(last[a], last[b]); w < end; w++) {
+                    count += __builtin_popcountll(rowA[w] & rowB[w]);
+                }
+                _matrix[a * _ucs + b] = count;
+                _matrix[b * _ucs + a] = count;
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned int t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (std::thread &thread: pool) thread.join();
+}
+
+/**
+ * @brief Inscreve um aluno numa UC, somando 1 às células dessa UC com as outras UCs do aluno.
+ * Complexidade: O(U), sendo U o número de UCs.
+ * @param student - Posição do aluno.
+ * @param ucId - Identificador da UC.
+ */
+void CoEnrollmentMatrix::add(uint32_t student, uint16_t ucId) {
+    if (student >= _students || ucId >= _ucs || contains(student, ucId)) return;
+    change(student, ucId, 1);
+    set(student, ucId);
+}
+
+/**
+ * @brief Retira um aluno de uma UC, subtraindo 1 às células dessa UC com as outras UCs do aluno.
+ * Complexidade: O(U), sendo U o número de UCs.
+ * @param student - Posição do aluno.
+ * @param ucId - Identificador da UC.
+ */
+void CoEnrollmentMatrix::remove(uint32_t student, uint16_t ucId) {
+    if (student >= _students || ucId >= _ucs || !contains(student, ucId)) return;
+    _bits[ucId * _words + student / 64] &= ~(uint64_t(1) << (student % 64));
+    change(student, ucId, -1);
+}
+
+/**
+ * @brief Permite obter o número de alunos inscritos em duas UCs (ou, se forem a mesma, o número de alunos da UC).
+ * Complexidade: O(1).
+ * @param a - Identificador da primeira UC.
+ * @param b - Identificador da segunda UC.
+ * @return Número de alunos.
+ */
+uint32_t CoEnrollmentMatrix::common(uint16_t a, uint16_t b) const {
+    if (a >= _ucs || b >= _ucs) return 0;
+    return _matrix[a * _ucs + b];
+}
+
+/**
+ * @brief Permite obter o número de UCs da matriz.
+ * Complexidade: O(1).
+ * @return Número de UCs.
+ */
+size_t CoEnrollmentMatrix::ucs() const {
+    return _ucs;
+}
+
+/**
+ * @brief Estima a memória dinâmica ocupada pelos conjuntos de alunos e pela matriz.
+ * Complexidade: O(1).
+ * @return Número de bytes.
+ */
+size_t CoEnrollmentMatrix::memoryUsage() const {
+    return MemoryUsage::vectorBuffer(_bits) + MemoryUsage::vectorBuffer(_matrix);
+}
+
+/**
+ * @brief Verifica se um aluno está inscrito numa UC.
+ * Complexidade: O(1).
+ */
+bool CoEnrollmentMatrix::contains(uint32_t student, uint16_t ucId) const {
+    return (_bits[ucId * _words + student / 64] >> (student % 64) & 1) != 0;
+}
+
+/**
+ * @brief Soma 'delta' às células de uma UC com todas as UCs do aluno (a própria UC incluída, na diagonal).
+ * Complexidade: O(U), sendo U o número de UCs.
+ */
+void CoEnrollmentMatrix::change(uint32_t student, uint16_t ucId, int delta) {
+    _matrix[ucId * _ucs + ucId] += delta;
+    for (size_t other = 0; other < _ucs; other++) {
+        if (other == ucId || !contains(student, other)) continue;
+        _matrix[ucId * _ucs + other] += delta;
+        _matrix[other * _ucs + ucId] += delta;
+    }
+}
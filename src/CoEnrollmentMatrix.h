@@ -0,0 +1,54 @@
+#ifndef PROJECT_1_SCHEDULE_COENROLLMENTMATRIX_H
+#define PROJECT_1_SCHEDULE_COENROLLMENTMATRIX_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Número de alunos inscritos em cada par de unidades curriculares (matriz de coinscrição), para marcar exames
+ * sem sobreposições.
+ * Cada UC tem um conjunto de bits com um bit por aluno (pela posição do aluno na tabela de estudantes). Cada célula da
+ * matriz é o número de bits a 1 da interseção de dois conjuntos, calculado palavra a palavra com popcount e só no
+ * intervalo de palavras em que as duas UCs têm alunos; as linhas da matriz são repartidas por várias threads. Depois
+ * de calculada, a matriz é atualizada incrementalmente quando um aluno entra ou sai de uma UC.
+ */
+
+class CoEnrollmentMatrix {
+public:
+    void reset(size_t students, size_t ucs);
+
+    void set(uint32_t student, uint16_t ucId);
+
+    void compute(unsigned int threads = 0);
+
+    void add(uint32_t student, uint16_t ucId);
+
+    void remove(uint32_t student, uint16_t ucId);
+
+    [[nodiscard]] uint32_t common(uint16_t a, uint16_t b) const;
+
+    [[nodiscard]] size_t ucs() const;
+
+    [[nodiscard]] size_t memoryUsage() const;
+
+private:
+    /** @brief Número de alunos. */
+    size_t _students = 0;
+    /** @brief Número de UCs. */
+    size_t _ucs = 0;
+    /** @brief Número de palavras de 64 bits do conjunto de cada UC. */
+    size_t _words = 0;
+    /** @brief Conjuntos de alunos das UCs, um a seguir ao outro (_words palavras por UC). */
+    std::vector<uint64_t> _bits;
+    /** @brief Matriz de coinscrição, linha a linha (a diagonal tem o número de alunos de cada UC). */
+    std::vector<uint32_t> _matrix;
+
+    [[nodiscard]] bool contains(uint32_t student, uint16_t ucId) const;
+
+    void change(uint32_t student, uint16_t ucId, int delta);
+};
+
+
+#endif //PROJECT_1_SCHEDULE_COENROLLMENTMATRIX_H
@@ -0,0 +1,278 @@
+#include "CohortPlacer.h"
+
+#include <algorithm>
+#include <numeric>
+
+/**
+ * @brief Construtor da classe CohortPlacer.
+ * Complexidade: O(T), sendo T o número de turmas.
+ * @param classesOfUc - Turmas de cada UC (a posição no vetor é o índice da UC usado em addStudent).
+ * @param table - Tabela das aulas das turmas.
+ */
+CohortPlacer::CohortPlacer(std::vector<std::vector<CohortClass>> classesOfUc, const LessonTable &table) : _table(table) {
+    for (uint32_t uc = 0; uc < classesOfUc.size(); uc++) {
+        _firstSlot.push_back(_slots.size());
+        for (CohortClass &info: classesOfUc[uc]) _slots.push_back({info, uc, {}});
+    }
+    _firstSlot.push_back(_slots.size());
+}
+
+/**
+ * @brief Adiciona um aluno ao grupo.
+ * Complexidade: O(U + K log C), sendo U o número de UCs pedidas, K o número de turmas que o aluno já tem e C o número
+ * de turmas da tabela.
+ * @param kept - Identificadores compactos das turmas que o aluno já tem.
+ * @param ucs - Índices das UCs pedidas, sem repetições.
+ * @return Índice do aluno no grupo.
+ */
+size_t CohortPlacer::addStudent(const std::vector<uint32_t> &kept, const std::vector<uint32_t> &ucs) {
+    _members.push_back({kept, _table.busyMask(kept), ucs, std::vector<int32_t>(ucs.size(), -1)});
+    return _members.size() - 1;
+}
+
+/**
+ * @brief Coloca todos os alunos do grupo (gulosa, reparação e balanceamento).
+ * Complexidade: O(N * A + M), sendo N o número de alunos, A o número máximo de combinações tentadas por aluno e M o
+ * número de mudanças de turma do balanceamento.
+ */
+void CohortPlacer::place() {
+    std::vector<uint32_t> order(_members.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return _members[a].ucs.size() > _members[b].ucs.size();
+    });
+
+    auto placeMember = [&](uint32_t member, bool allowFull) {
+        const Member &m = _members[member];
+        std::vector<uint32_t> ucOrder(m.ucs.size());
+        std::iota(ucOrder.begin(), ucOrder.end(), 0);
+        auto freeSlots = [&](uint32_t index) {
+            uint32_t uc = m.ucs[index], free = 0;
+            for (uint32_t s = _firstSlot[uc]; s < _firstSlot[uc + 1]; s++) {
+                free += _slots[s].info.size < _slots[s].info.capacity;
+            }
+            return free;
+        };
+        std::stable_sort(ucOrder.begin(), ucOrder.end(),
+                         [&](uint32_t a, uint32_t b) { return freeSlots(a) < freeSlots(b); });
+        unsigned int attempts = 0;
+        search(member, ucOrder, 0, m.busy, allowFull, attempts);
+    };
+
+    for (uint32_t member: order) placeMember(member, false);
+    for (uint32_t member: order) {
+        const std::vector<int32_t> &slots = _members[member].slots;
+        if (std::find(slots.begin(), slots.end(), -1) != slots.end()) placeMember(member, true);
+    }
+    for (uint32_t uc = 0; uc + 1 < _firstSlot.size(); uc++) balance(uc);
+}
+
+/**
+ * @brief Procura em profundidade uma turma para cada UC de um aluno, experimentando as turmas menos cheias primeiro.
+ * Complexidade: O(A), sendo A o número máximo de combinações tentadas.
+ * @param member - Aluno.
+ * @param order - Ordem pela qual as UCs do aluno são percorridas (índices em Member::ucs).
+ * @param depth - Número de UCs já escolhidas.
+ * @param busy - Meias horas já ocupadas.
+ * @param allowFull - Se verdadeiro, uma turma cheia pode ser usada se outro aluno do grupo puder sair dela.
+ * @param attempts - Combinações tentadas até agora.
+ * @return Verdadeiro se o aluno ficou colocado em todas as UCs, falso caso contrário (e nesse caso não fica em nenhuma
+ * e as mudanças feitas para lhe libertar lugares são desfeitas).
+ */
+bool CohortPlacer::search(uint32_t member, const std::vector<uint32_t> &order, size_t depth,
+                          const LessonTable::Mask &busy, bool allowFull, unsigned int &attempts) {
+    if (depth == order.size()) return true;
+    uint32_t index = order[depth], uc = _members[member].ucs[index];
+    std::vector<uint32_t> candidates(_firstSlot[uc + 1] - _firstSlot[uc]);
+    std::iota(candidates.begin(), candidates.end(), _firstSlot[uc]);
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [&](uint32_t a, uint32_t b) { return _slots[a].info.size < _slots[b].info.size; });
+
+    for (uint32_t slot: candidates) {
+        if (++attempts > MAX_ATTEMPTS) return false;
+        const CohortClass &info = _slots[slot].info;
+        if (!fits(member, index, busy, slot)) continue;
+        Move move{};
+        bool full = info.size >= info.capacity;
+        if (full && (!allowFull || !freeSeat(slot, member, move))) continue;
+        assign(member, index, static_cast<int32_t>(slot));
+        LessonTable::Mask next = busy;
+        LessonTable::merge(next, info.busy);
+        if (search(member, order, depth + 1, next, allowFull, attempts)) return true;
+        assign(member, index, -1);
+        if (full) {
+            assign(move.member, move.index, static_cast<int32_t>(move.from));
+            _repairMoves--;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Verifica se uma turma cabe no horário de um aluno do grupo (as turmas que já tinha e as escolhidas nas outras
+ * UCs). Com máscaras exatas basta intersetá-las; caso contrário, as aulas são comparadas uma a uma.
+ * Complexidade: O(1) com máscaras exatas; O((K + U) * (A^2 + log C)) caso contrário, sendo K o número de turmas que o
+ * aluno já tinha, U o número de UCs pedidas, A o número de aulas de cada turma e C o número de turmas da tabela.
+ * @param member - Aluno.
+ * @param skipped - Índice da UC cuja turma não conta (a UC da turma testada).
+ * @param busy - Meias horas ocupadas pelo aluno sem a UC 'skipped'.
+ * @param slot - Turma.
+ * @return Verdadeiro se não houver sobreposições, falso caso contrário.
+ */
+bool CohortPlacer::fits(uint32_t member, size_t skipped, const LessonTable::Mask &busy, uint32_t slot) const {
+    if (_table.isAligned()) return !LessonTable::intersects(busy, _slots[slot].info.busy);
+    const Member &m = _members[member];
+    uint32_t classId = _slots[slot].info.classId;
+    for (uint32_t kept: m.kept) {
+        if (_table.conflicts(kept, classId)) return false;
+    }
+    for (size_t i = 0; i < m.slots.size(); i++) {
+        if (i != skipped && m.slots[i] >= 0 && _table.conflicts(_slots[m.slots[i]].info.classId, classId)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Tenta libertar um lugar numa turma cheia, mudando outro aluno do grupo para uma turma da mesma UC com vagas
+ * e sem sobreposições com o resto do seu horário.
+ * Complexidade: O(K * T), sendo K o número de alunos do grupo na turma e T o número de turmas da UC.
+ * @param slot - Turma cheia.
+ * @param entering - Aluno que quer entrar na turma (não é mudado).
+ * @param move - Mudança feita, para poder ser desfeita se o aluno acabar por não ficar na turma.
+ * @return Verdadeiro se foi libertado um lugar, falso caso contrário.
+ */
+bool CohortPlacer::freeSeat(uint32_t slot, uint32_t entering, Move &move) {
+    uint32_t uc = _slots[slot].uc;
+    for (uint32_t other: _slots[slot].members) {
+        if (other == entering) continue;
+        const Member &m = _members[other];
+        size_t index = std::find(m.slots.begin(), m.slots.end(), static_cast<int32_t>(slot)) - m.slots.begin();
+        LessonTable::Mask busy = maskWithout(other, index);
+        for (uint32_t target = _firstSlot[uc]; target < _firstSlot[uc + 1]; target++) {
+            const CohortClass &info = _slots[target].info;
+            if (target == slot || info.size >= info.capacity || !fits(other, index, busy, target)) continue;
+            assign(other, index, static_cast<int32_t>(target));
+            move = {other, index, slot};
+            _repairMoves++;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Equilibra as turmas de uma UC, mudando alunos do grupo das turmas mais cheias para as menos cheias enquanto
+ * a diferença for de pelo menos dois alunos. Cada mudança diminui a soma dos quadrados do número de alunos das turmas,
+ * pelo que o ciclo termina.
+ * Complexidade: O(M * T^2 * K), sendo M o número de mudanças, T o número de turmas da UC e K o número de alunos do
+ * grupo numa turma.
+ * @param uc - Índice da UC.
+ */
+void CohortPlacer::balance(uint32_t uc) {
+    std::vector<uint32_t> slots(_firstSlot[uc + 1] - _firstSlot[uc]);
+    bool moved = true;
+    while (moved) {
+        moved = false;
+        std::iota(slots.begin(), slots.end(), _firstSlot[uc]);
+        std::stable_sort(slots.begin(), slots.end(),
+                         [&](uint32_t a, uint32_t b) { return _slots[a].info.size > _slots[b].info.size; });
+        for (size_t from = 0; from < slots.size() && !moved; from++) {
+            for (size_t to = slots.size(); to-- > from + 1 && !moved;) {
+                const CohortClass &source = _slots[slots[from]].info, &target = _slots[slots[to]].info;
+                if (source.size < target.size + 2) break;
+                if (target.size >= target.capacity) continue;
+                for (uint32_t member: _slots[slots[from]].members) {
+                    const Member &m = _members[member];
+                    size_t index = std::find(m.slots.begin(), m.slots.end(), static_cast<int32_t>(slots[from])) -
+                                   m.slots.begin();
+                    if (!fits(member, index, maskWithout(member, index), slots[to])) continue;
+                    assign(member, index, static_cast<int32_t>(slots[to]));
+                    _balanceMoves++;
+                    moved = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Calcula as meias horas ocupadas por um aluno do grupo, sem contar a turma de uma das UCs.
+ * Complexidade: O(U), sendo U o número de UCs pedidas pelo aluno.
+ * @param member - Aluno.
+ * @param skipped - Índice da UC que não conta.
+ * @return Máscara da semana.
+ */
+LessonTable::Mask CohortPlacer::maskWithout(uint32_t member, size_t skipped) const {
+    const Member &m = _members[member];
+    LessonTable::Mask busy = m.busy;
+    for (size_t i = 0; i < m.slots.size(); i++) {
+        if (i != skipped && m.slots[i] >= 0) LessonTable::merge(busy, _slots[m.slots[i]].info.busy);
+    }
+    return busy;
+}
+
+/**
+ * @brief Muda a turma de um aluno do grupo numa UC, atualizando a ocupação das turmas.
+ * Complexidade: O(K), sendo K o número de alunos do grupo na turma antiga.
+ * @param member - Aluno.
+ * @param index - Índice da UC (em Member::ucs).
+ * @param slot - Nova turma, ou -1 para retirar o aluno da UC.
+ */
+void CohortPlacer::assign(uint32_t member, size_t index, int32_t slot) {
+    int32_t old = _members[member].slots[index];
+    if (old >= 0) {
+        std::vector<uint32_t> &members = _slots[old].members;
+        members.erase(std::find(members.begin(), members.end(), member));
+        _slots[old].info.size--;
+    }
+    if (slot >= 0) {
+        _slots[slot].members.push_back(member);
+        _slots[slot].info.size++;
+    }
+    _members[member].slots[index] = slot;
+}
+
+/**
+ * @brief Permite obter as turmas onde um aluno do grupo ficou colocado.
+ * Complexidade: O(U), sendo U o número de UCs pedidas pelo aluno.
+ * @param student - Índice do aluno no grupo.
+ * @return Identificadores compactos das turmas, pela ordem das UCs pedidas (vazio se o aluno não foi colocado).
+ */
+std::vector<uint32_t> CohortPlacer::placement(size_t student) const {
+    std::vector<uint32_t> classIds;
+    for (int32_t slot: _members[student].slots) {
+        if (slot < 0) return {};
+        classIds.push_back(_slots[slot].info.classId);
+    }
+    return classIds;
+}
+
+/**
+ * @brief Permite obter o número de alunos do grupo que não foram colocados.
+ * Complexidade: O(N * U), sendo N o número de alunos e U o número de UCs pedidas por aluno.
+ * @return Número de alunos.
+ */
+size_t CohortPlacer::unplacedStudents() const {
+    size_t unplaced = 0;
+    for (const Member &m: _members) unplaced += std::find(m.slots.begin(), m.slots.end(), -1) != m.slots.end();
+    return unplaced;
+}
+
+/**
+ * @brief Permite obter o número de alunos mudados de turma na reparação.
+ * Complexidade: O(1).
+ * @return Número de mudanças.
+ */
+unsigned int CohortPlacer::repairMoves() const {
+    return _repairMoves;
+}
+
+/**
+ * @brief Permite obter o número de alunos mudados de turma no balanceamento.
+ * Complexidade: O(1).
+ * @return Número de mudanças.
+ */
+unsigned int CohortPlacer::balanceMoves() const {
+    return _balanceMoves;
+}
@@ -0,0 +1,116 @@
+#ifndef PROJECT_1_SCHEDULE_COHORTPLACER_H
+#define PROJECT_1_SCHEDULE_COHORTPLACER_H
+
+
+#include <cstdint>
+#include <vector>
+#include "LessonTable.h"
+
+/**
+ * @brief Turma onde podem ser colocados alunos de um grupo (coorte).
+ */
+
+struct CohortClass {
+    /** @brief Identificador compacto da turma. */
+    uint32_t classId;
+    /** @brief Meias horas ocupadas pelas aulas não teóricas da turma. */
+    LessonTable::Mask busy;
+    /** @brief Número de alunos já inscritos na turma (fora do grupo). */
+    unsigned int size;
+    /** @brief Capacidade máxima da turma. */
+    unsigned int capacity;
+};
+
+/**
+ * @brief Coloca um grupo inteiro de alunos nas turmas das UCs que cada um pede, de uma só vez, sem sobreposições e
+ * sem exceder a capacidade das turmas, deixando as turmas de cada UC o mais equilibradas possível.
+ * A colocação tem três fases:
+ * 1. gulosa: cada aluno (os que pedem mais UCs primeiro) fica com a primeira combinação sem sobreposições encontrada
+ *    escolhendo, em cada UC, as turmas menos cheias primeiro;
+ * 2. reparação: um aluno que não coube em nenhuma combinação pode entrar numa turma cheia se for possível mudar outro
+ *    aluno do grupo dessa turma para outra turma da mesma UC com vagas;
+ * 3. balanceamento: enquanto a turma mais cheia de uma UC tiver pelo menos mais dois alunos do que outra turma da
+ *    mesma UC, um aluno do grupo é mudado de uma para a outra, se não criar sobreposições.
+ * Só os alunos do grupo são mudados de turma; os alunos já inscritos contam apenas para a ocupação.
+ * As sobreposições são testadas com as máscaras das turmas; se as máscaras da tabela de aulas não forem exatas, as
+ * aulas são comparadas uma a uma.
+ */
+
+class CohortPlacer {
+public:
+    /** @brief Número máximo de combinações tentadas para cada aluno antes de desistir. */
+    static const unsigned int MAX_ATTEMPTS = 20000;
+
+    CohortPlacer(std::vector<std::vector<CohortClass>> classesOfUc, const LessonTable &table);
+
+    size_t addStudent(const std::vector<uint32_t> &kept, const std::vector<uint32_t> &ucs);
+
+    void place();
+
+    [[nodiscard]] std::vector<uint32_t> placement(size_t student) const;
+
+    [[nodiscard]] size_t unplacedStudents() const;
+
+    [[nodiscard]] unsigned int repairMoves() const;
+
+    [[nodiscard]] unsigned int balanceMoves() const;
+
+private:
+    /**
+     * @brief Turma, com a ocupação atual e os alunos do grupo colocados nela.
+     */
+    struct Slot {
+        CohortClass info;
+        uint32_t uc;
+        std::vector<uint32_t> members;
+    };
+
+    /**
+     * @brief Aluno do grupo: as turmas que já tinha, as UCs pedidas e a turma escolhida em cada uma.
+     */
+    struct Member {
+        std::vector<uint32_t> kept;
+        LessonTable::Mask busy;
+        std::vector<uint32_t> ucs;
+        std::vector<int32_t> slots;
+    };
+
+    /**
+     * @brief Mudança de turma de um aluno do grupo, feita para libertar um lugar.
+     */
+    struct Move {
+        uint32_t member;
+        size_t index;
+        uint32_t from;
+    };
+
+    /** @brief Tabela das aulas das turmas. */
+    const LessonTable &_table;
+
+    /** @brief Turmas, agrupadas por UC. */
+    std::vector<Slot> _slots;
+    /** @brief Posição em _slots da primeira turma de cada UC (com uma posição extra no fim). */
+    std::vector<uint32_t> _firstSlot;
+    /** @brief Alunos do grupo, pela ordem em que foram adicionados. */
+    std::vector<Member> _members;
+    /** @brief Número de alunos mudados de turma na reparação. */
+    unsigned int _repairMoves = 0;
+    /** @brief Número de alunos mudados de turma no balanceamento. */
+    unsigned int _balanceMoves = 0;
+
+    [[nodiscard]] LessonTable::Mask maskWithout(uint32_t member, size_t skipped) const;
+
+    bool search(uint32_t member, const std::vector<uint32_t> &order, size_t depth, const LessonTable::Mask &busy,
+                bool allowFull, unsigned int &attempts);
+
+    [[nodiscard]] bool fits(uint32_t member, size_t skipped, const LessonTable::Mask &busy, uint32_t slot) const;
+
+    bool freeSeat(uint32_t slot, uint32_t entering, Move &move);
+
+    void assign(uint32_t member, size_t index, int32_t slot);
+
+    void balance(uint32_t uc);
+};
+
+
+#endif //PROJECT_1_SCHEDULE_COHORTPLACER_H
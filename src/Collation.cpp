@@ -0,0 +1,38 @@
+#include "Collation.h"
+
+namespace {
+    /**
+     * @brief Letra base (minúscula) de cada carácter entre U+00C0 e U+00FF, ou nullptr se não for uma letra.
+     */
+    const char *const LATIN1_BASE[64] = {
+            "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+            "d", "n", "o", "o", "o", "o", "o", nullptr, "o", "u", "u", "u", "u", "y", "th", "ss",
+            "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+            "d", "n", "o", "o", "o", "o", "o", nullptr, "o", "u", "u", "u", "u", "y", "th", "y",
+    };
+}
+
+/**
+ * @brief Calcula a chave de ordenação de um texto: letras ASCII em minúscula e letras acentuadas substituídas pela
+ * letra base; os restantes caracteres ficam iguais.
+ * Complexidade: O(N), sendo N o tamanho do texto.
+ * @param text - Texto em UTF-8.
+ * @return Chave; comparar chaves byte a byte dá a ordem alfabética sem distinguir acentos nem maiúsculas.
+ */
+std::string Collation::key(const std::string &text) {
+    std::string key;
+    key.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+        auto c = static_cast<unsigned char>(text[i]);
+        if (c == 0xC3 && i + 1 < text.size()) {
+            auto next = static_cast<unsigned char>(text[i + 1]);
+            if (next >= 0x80 && next <= 0xBF && LATIN1_BASE[next - 0x80] != nullptr) {
+                key += LATIN1_BASE[next - 0x80];
+                i++;
+                continue;
+            }
+        }
+        key += c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : char(c);
+    }
+    return key;
+}
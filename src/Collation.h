@@ -0,0 +1,19 @@
+#ifndef PROJECT_1_SCHEDULE_COLLATION_H
+#define PROJECT_1_SCHEDULE_COLLATION_H
+
+
+#include <string>
+
+/**
+ * @brief Chaves de ordenação para nomes em português: as letras acentuadas (UTF-8, Latin-1) contam como a letra base
+ * e as maiúsculas como minúsculas, de forma a que "Álvaro" fique junto de "Alberto" e não depois de "Zé".
+ */
+
+class Collation {
+public:
+
+    static std::string key(const std::string &text);
+};
+
+
+#endif //PROJECT_1_SCHEDULE_COLLATION_H
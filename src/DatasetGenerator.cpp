@@ -0,0 +1,357 @@
+#include "DatasetGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+namespace {
+    const char *const WEEK_DAYS[] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
+
+    const char *const FIRST_NAMES[] = {"Ana", "Beatriz", "Carolina", "Inês", "João", "José", "Luís", "Mário", "Sofia",
+                                       "Tomás", "Gonçalo", "Leonor", "Matilde", "Rúben", "André", "Íris", "Óscar",
+                                       "Ângela", "Vítor", "Iara", "Gisela", "Rita", "Pedro", "Miguel", "Diogo",
+                                       "Francisco", "Marta", "Mariana", "Raquel", "Tiago", "Jose Jesualdo", "Álvaro"};
+
+    const char *const SURNAMES[] = {"Silva", "Santos", "Ferreira", "Pereira", "Oliveira", "Costa", "Rodrigues",
+                                    "Martins", "Jesus", "Sousa", "Fernandes", "Gonçalves", "Gomes", "Lopes", "Marques",
+                                    "Alves", "Almeida", "Ribeiro", "Pinto", "Carvalho", "Teixeira", "Moreira",
+                                    "Correia", "Mendes", "Nunes", "Soares", "Vieira", "Monteiro", "Cardoso", "Araújo"};
+
+    /** @brief Primeira e última meia hora em que pode haver aulas (08:00 - 20:00). */
+    const unsigned int FIRST_SLOT = 16, LAST_SLOT = 40;
+    /** @brief Ano de entrada dos estudantes do 1º ano. */
+    const unsigned int ENTRY_YEAR = 2023;
+}
+
+/**
+ * @brief Construtor da classe DatasetGenerator.
+ * Complexidade: O(C), sendo C o número de turmas por unidade curricular.
+ * @param config - Parâmetros do gerador.
+ */
+DatasetGenerator::DatasetGenerator(const GeneratorConfig &config) : _config(config), _rng(config.seed) {
+    std::vector<double> weights;
+    for (unsigned int i = 0; i < _config.classesPerUc; i++) {
+        weights.push_back(1.0 / std::sqrt(i + 1.0));
+    }
+    _classDistribution = std::discrete_distribution<unsigned int>(weights.begin(), weights.end());
+}
+
+/**
+ * @brief Gera todos os ficheiros CSV na pasta indicada (classes.csv, classes_per_uc.csv, students_classes.csv e
+ * requests.csv).
+ * Complexidade: O(U*C*L + S + R).
+ * @param outputDir - Pasta de destino.
+ * @return Verdadeiro se todos os ficheiros foram escritos, falso caso contrário.
+ */
+bool DatasetGenerator::generate(const std::string &outputDir) {
+    std::error_code error;
+    std::filesystem::create_directories(outputDir, error);
+    if (error) return false;
+
+    generateLessons();
+    generateStudents();
+    return writeClasses(outputDir) && writeClassesPerUc(outputDir) && writeUcs(outputDir)
+           && writeStudentsClasses(outputDir) && writeRequests(outputDir);
+}
+
+/**
+ * @brief Permite obter o número total de unidades curriculares.
+ * Complexidade: O(1).
+ * @return Número de unidades curriculares.
+ */
+unsigned int DatasetGenerator::numUcs() const {
+    return _config.years * _config.ucsPerYear;
+}
+
+/**
+ * @brief Permite obter o código de uma unidade curricular, seguindo o padrão dos dados reais (L.EIC001, L.EIC011...).
+ * Complexidade: O(1).
+ * @param uc - Índice da unidade curricular.
+ * @return Código da unidade curricular.
+ */
+std::string DatasetGenerator::ucCode(unsigned int uc) const {
+    unsigned int year = uc / _config.ucsPerYear, local = uc % _config.ucsPerYear;
+    unsigned int number = _config.ucsPerYear < 10 ? year * 10 + local + 1 : uc + 1;
+    std::ostringstream code;
+    code << "L.EIC" << std::setw(3) << std::setfill('0') << number;
+    return code.str();
+}
+
+/**
+ * @brief Permite obter o código de uma turma (1LEIC01, 2LEIC05...).
+ * Complexidade: O(1).
+ * @param uc - Índice da unidade curricular.
+ * @param turma - Índice da turma.
+ * @return Código da turma.
+ */
+std::string DatasetGenerator::classCode(unsigned int uc, unsigned int turma) const {
+    std::ostringstream code;
+    code << uc / _config.ucsPerYear + 1 << "LEIC" << std::setw(2) << std::setfill('0') << turma + 1;
+    return code.str();
+}
+
+/**
+ * @brief Escolhe uma turma de forma enviesada, favorecendo as primeiras turmas.
+ * Complexidade: O(log C).
+ * @return Índice da turma.
+ */
+unsigned int DatasetGenerator::skewedClass() {
+    return _classDistribution(_rng);
+}
+
+/**
+ * @brief Gera as aulas de todas as turmas. Cada unidade curricular tem uma aula teórica comum a todas as turmas e as
+ * restantes aulas práticas são colocadas, sempre que possível, sem sobreposição com as outras aulas da mesma turma.
+ * Complexidade: O(U*C*L).
+ */
+void DatasetGenerator::generateLessons() {
+    unsigned int theoretical = _config.lessonsPerClass >= 2 ? 1 : 0;
+    unsigned int practical = _config.lessonsPerClass - theoretical;
+    std::uniform_int_distribution<unsigned int> dayDistribution(0, 4);
+    std::discrete_distribution<unsigned int> durationDistribution({0, 0, 3, 3, 4});
+    std::uniform_real_distribution<double> probability(0, 1);
+
+    _lessons.assign(numUcs() * _config.classesPerUc, {});
+    for (unsigned int year = 0; year < _config.years; year++) {
+        // ocupação das aulas práticas de cada turma do ano, em meias horas
+        std::vector<std::vector<bool>> busy(_config.classesPerUc, std::vector<bool>(5 * 48, false));
+        for (unsigned int local = 0; local < _config.ucsPerYear; local++) {
+            unsigned int uc = year * _config.ucsPerYear + local;
+            std::vector<GeneratedLesson> tLessons;
+            for (unsigned int i = 0; i < theoretical; i++) {
+                unsigned int duration = durationDistribution(_rng);
+                unsigned int start = std::uniform_int_distribution<unsigned int>(FIRST_SLOT, LAST_SLOT - duration)(_rng);
+                tLessons.push_back({dayDistribution(_rng), start, duration, "T"});
+            }
+            for (unsigned int turma = 0; turma < _config.classesPerUc; turma++) {
+                std::vector<GeneratedLesson> &lessons = _lessons[uc * _config.classesPerUc + turma];
+                lessons = tLessons;
+                for (unsigned int i = 0; i < practical; i++) {
+                    GeneratedLesson lesson{};
+                    for (int attempt = 0; attempt < 20; attempt++) {
+                        unsigned int duration = durationDistribution(_rng);
+                        lesson = {dayDistribution(_rng),
+                                  std::uniform_int_distribution<unsigned int>(FIRST_SLOT, LAST_SLOT - duration)(_rng),
+                                  duration, probability(_rng) < 0.85 ? "TP" : "PL"};
+                        bool free = true;
+                        for (unsigned int slot = lesson.start; slot < lesson.start + lesson.duration; slot++) {
+                            free = free && !busy[turma][lesson.day * 48 + slot];
+                        }
+                        if (free) break;
+                    }
+                    for (unsigned int slot = lesson.start; slot < lesson.start + lesson.duration; slot++) {
+                        busy[turma][lesson.day * 48 + slot] = true;
+                    }
+                    lessons.push_back(lesson);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Gera os estudantes e as suas inscrições. A maioria dos estudantes frequenta todas as unidades curriculares do
+ * seu ano na mesma turma; alguns trocam de turma numa delas, desistem de unidades curriculares ou repetem unidades
+ * curriculares de anos anteriores.
+ * Complexidade: O(S).
+ */
+void DatasetGenerator::generateStudents() {
+    std::vector<double> yearWeights;
+    for (unsigned int year = 0; year < _config.years; year++) {
+        yearWeights.push_back(_config.years - year + 1.0);
+    }
+    std::discrete_distribution<unsigned int> yearDistribution(yearWeights.begin(), yearWeights.end());
+    std::uniform_real_distribution<double> probability(0, 1);
+    std::uniform_int_distribution<unsigned int> firstName(0, std::size(FIRST_NAMES) - 1);
+    std::uniform_int_distribution<unsigned int> surname(0, std::size(SURNAMES) - 1);
+
+    std::vector<unsigned int> studentsPerYear(_config.years, 0);
+    for (unsigned int i = 0; i < _config.students; i++) {
+        studentsPerYear[yearDistribution(_rng)]++;
+    }
+
+    _studentCodes.clear();
+    _studentNames.clear();
+    _enrollmentStart.assign(1, 0);
+    _enrollments.clear();
+    for (unsigned int year = 0; year < _config.years; year++) {
+        unsigned int prefix = ENTRY_YEAR - year, suffix = 0;
+        for (unsigned int k = 0; k < studentsPerYear[year]; k++) {
+            suffix += 1 + (probability(_rng) < 0.3 ? _rng() % 4 : 0);
+            if (suffix > 99999) {
+                prefix -= _config.years;
+                suffix = 1;
+            }
+            _studentCodes.push_back(prefix * 100000 + suffix);
+            std::string name = FIRST_NAMES[firstName(_rng)];
+            if (probability(_rng) < 0.5) name += std::string(" ") + SURNAMES[surname(_rng)];
+            _studentNames.push_back(name);
+
+            unsigned int home = skewedClass();
+            std::vector<unsigned int> ucs;
+            for (unsigned int local = 0; local < _config.ucsPerYear; local++) {
+                ucs.push_back(year * _config.ucsPerYear + local);
+            }
+            std::shuffle(ucs.begin(), ucs.end(), _rng);
+            if (probability(_rng) > 0.75) {
+                ucs.resize(ucs.size() - std::min<size_t>(ucs.size() - 1, 1 + _rng() % 2));
+            }
+            if (year > 0 && probability(_rng) < 0.15) {
+                ucs.push_back((year - 1) * _config.ucsPerYear + _rng() % _config.ucsPerYear);
+            }
+            if (ucs.size() > 7) ucs.resize(7);
+            for (unsigned int uc: ucs) {
+                unsigned int turma = uc / _config.ucsPerYear == year && probability(_rng) < 0.85 ? home : skewedClass();
+                _enrollments.emplace_back(uc, turma);
+            }
+            _enrollmentStart.push_back(_enrollments.size());
+        }
+    }
+}
+
+/**
+ * @brief Escreve o ficheiro classes.csv.
+ * Complexidade: O(U*C*L).
+ * @param outputDir - Pasta de destino.
+ * @return Verdadeiro se o ficheiro foi escrito, falso caso contrário.
+ */
+bool DatasetGenerator::writeClasses(const std::string &outputDir) const {
+    std::ofstream file(outputDir + "/classes.csv");
+    file << "ClassCode,UcCode,Weekday,StartHour,Duration,Type\r\n";
+    for (unsigned int uc = 0; uc < numUcs(); uc++) {
+        std::string code = ucCode(uc);
+        for (unsigned int turma = 0; turma < _config.classesPerUc; turma++) {
+            for (const GeneratedLesson &lesson: _lessons[uc * _config.classesPerUc + turma]) {
+                file << classCode(uc, turma) << ',' << code << ',' << WEEK_DAYS[lesson.day] << ','
+                     << lesson.start / 2.0 << ',' << lesson.duration / 2.0 << ',' << lesson.type << "\r\n";
+            }
+        }
+    }
+    return file.good();
+}
+
+/**
+ * @brief Escreve o ficheiro classes_per_uc.csv.
+ * Complexidade: O(U*C).
+ * @param outputDir - Pasta de destino.
+ * @return Verdadeiro se o ficheiro foi escrito, falso caso contrário.
+ */
+bool DatasetGenerator::writeClassesPerUc(const std::string &outputDir) const {
+    std::ofstream file(outputDir + "/classes_per_uc.csv");
+    file << "UcCode,ClassCode\r\n";
+    for (unsigned int uc = 0; uc < numUcs(); uc++) {
+        for (unsigned int turma = 0; turma < _config.classesPerUc; turma++) {
+            file << ucCode(uc) << ',' << classCode(uc, turma) << "\r\n";
+        }
+    }
+    return file.good();
+}
+
+/**
+ * @brief Escreve o ficheiro ucs.csv (catálogo das unidades curriculares, com 6 créditos cada).
+ * Complexidade: O(U).
+ * @param outputDir - Pasta de destino.
+ * @return Verdadeiro se o ficheiro foi escrito, falso caso contrário.
+ */
+bool DatasetGenerator::writeUcs(const std::string &outputDir) const {
+    std::ofstream file(outputDir + "/ucs.csv");
+    file << "UcCode,UcName,Year,Credits\r\n";
+    for (unsigned int uc = 0; uc < numUcs(); uc++) {
+        std::string code = ucCode(uc);
+        file << code << ",UC " << code.substr(5) << ',' << uc / _config.ucsPerYear + 1 << ",6\r\n";
+    }
+    return file.good();
+}
+
+/**
+ * @brief Escreve o ficheiro students_classes.csv.
+ * Complexidade: O(S).
+ * @param outputDir - Pasta de destino.
+ * @return Verdadeiro se o ficheiro foi escrito, falso caso contrário.
+ */
+bool DatasetGenerator::writeStudentsClasses(const std::string &outputDir) const {
+    std::vector<std::string> ucCodes;
+    for (unsigned int uc = 0; uc < numUcs(); uc++) ucCodes.push_back(ucCode(uc));
+
+    std::ofstream file(outputDir + "/students_classes.csv");
+    file << "StudentCode,StudentName,UcCode,ClassCode\r\n";
+    for (size_t student = 0; student < _studentCodes.size(); student++) {
+        for (uint32_t i = _enrollmentStart[student]; i < _enrollmentStart[student + 1]; i++) {
+            unsigned int uc = _enrollments[i].first;
+            file << _studentCodes[student] << ',' << _studentNames[student] << ',' << ucCodes[uc] << ','
+                 << classCode(uc, _enrollments[i].second) << "\r\n";
+        }
+    }
+    return file.good();
+}
+
+/**
+ * @brief Escreve o ficheiro requests.csv (Type,StudentCode,UcCode,ClassCode,CurrentUcCode), com uma mistura de
+ * pedidos de alteração de turma, inscrição, cancelamento e alteração de UC, válidos no estado inicial dos dados.
+ * Complexidade: O(R).
+ * @param outputDir - Pasta de destino.
+ * @return Verdadeiro se o ficheiro foi escrito, falso caso contrário.
+ */
+bool DatasetGenerator::writeRequests(const std::string &outputDir) {
+    std::ofstream file(outputDir + "/requests.csv");
+    file << "Type,StudentCode,UcCode,ClassCode,CurrentUcCode\r\n";
+    if (_studentCodes.empty()) return file.good();
+
+    std::discrete_distribution<int> typeDistribution({40, 20, 20, 20});
+    std::uniform_int_distribution<size_t> studentDistribution(0, _studentCodes.size() - 1);
+    auto enrolledIn = [this](size_t student, unsigned int uc) {
+        for (uint32_t i = _enrollmentStart[student]; i < _enrollmentStart[student + 1]; i++) {
+            if (_enrollments[i].first == uc) return true;
+        }
+        return false;
+    };
+    auto notEnrolledUc = [&](size_t student, unsigned int near) {
+        for (int attempt = 0; attempt < 10; attempt++) {
+            unsigned int year = near / _config.ucsPerYear;
+            unsigned int uc = attempt < 5 ? year * _config.ucsPerYear + _rng() % _config.ucsPerYear : _rng() % numUcs();
+            if (!enrolledIn(student, uc)) return (int) uc;
+        }
+        return -1;
+    };
+
+    unsigned int written = 0;
+    while (written < _config.requests) {
+        size_t student = studentDistribution(_rng);
+        uint32_t first = _enrollmentStart[student], count = _enrollmentStart[student + 1] - first;
+        if (count == 0) continue;
+        std::pair<uint32_t, uint32_t> current = _enrollments[first + _rng() % count];
+        std::string code = std::to_string(_studentCodes[student]);
+
+        switch (typeDistribution(_rng)) {
+            case 0: {
+                unsigned int turma = skewedClass();
+                if (turma == current.second) continue;
+                file << "Change Class," << code << ',' << ucCode(current.first) << ','
+                     << classCode(current.first, turma) << ",\r\n";
+                break;
+            }
+            case 1: {
+                int uc = notEnrolledUc(student, current.first);
+                if (uc < 0) continue;
+                file << "Enrollment," << code << ',' << ucCode(uc) << ',' << classCode(uc, skewedClass()) << ",\r\n";
+                break;
+            }
+            case 2:
+                file << "Removal," << code << ',' << ucCode(current.first) << ','
+                     << classCode(current.first, current.second) << ",\r\n";
+                break;
+            default: {
+                int uc = notEnrolledUc(student, current.first);
+                if (uc < 0) continue;
+                file << "Change Uc," << code << ',' << ucCode(uc) << ',' << classCode(uc, skewedClass()) << ','
+                     << ucCode(current.first) << "\r\n";
+            }
+        }
+        written++;
+    }
+    return file.good();
+}
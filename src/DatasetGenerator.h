@@ -0,0 +1,94 @@
+#ifndef PROJECT_1_SCHEDULE_DATASETGENERATOR_H
+#define PROJECT_1_SCHEDULE_DATASETGENERATOR_H
+
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Parâmetros do gerador de dados sintéticos.
+ */
+
+struct GeneratorConfig {
+    /** @brief Número de anos do curso. */
+    unsigned int years = 3;
+    /** @brief Número de unidades curriculares por ano. */
+    unsigned int ucsPerYear = 5;
+    /** @brief Número de turmas de cada unidade curricular. */
+    unsigned int classesPerUc = 15;
+    /** @brief Número de aulas de cada turma. */
+    unsigned int lessonsPerClass = 3;
+    /** @brief Número de estudantes. */
+    unsigned int students = 700;
+    /** @brief Número de pedidos a gerar. */
+    unsigned int requests = 1000;
+    /** @brief Semente do gerador de números aleatórios. */
+    unsigned int seed = 42;
+};
+
+/**
+ * @brief Classe que gera um conjunto de dados sintético (turmas, estudantes e pedidos) nos formatos CSV usados
+ * pelo ScheduleManager, de forma a testar o programa em grande escala.
+ */
+
+class DatasetGenerator {
+public:
+
+    explicit DatasetGenerator(const GeneratorConfig &config);
+
+    bool generate(const std::string &outputDir);
+
+private:
+    /** @brief Aula gerada, com horas em meias horas desde as 00:00. */
+    struct GeneratedLesson {
+        unsigned int day;
+        unsigned int start;
+        unsigned int duration;
+        std::string type;
+    };
+
+    /** @brief Parâmetros do gerador. */
+    GeneratorConfig _config;
+    /** @brief Gerador de números aleatórios. */
+    std::mt19937 _rng;
+    /** @brief Distribuição enviesada das turmas, para que algumas fiquem mais cheias do que outras. */
+    std::discrete_distribution<unsigned int> _classDistribution;
+    /** @brief Aulas de cada turma, indexadas por (uc * classesPerUc + turma). */
+    std::vector<std::vector<GeneratedLesson>> _lessons;
+    /** @brief Códigos UP dos estudantes. */
+    std::vector<unsigned int> _studentCodes;
+    /** @brief Nomes dos estudantes. */
+    std::vector<std::string> _studentNames;
+    /** @brief Início das inscrições de cada estudante em _enrollments. */
+    std::vector<uint32_t> _enrollmentStart;
+    /** @brief Inscrições (uc, turma) de todos os estudantes, contíguas por estudante. */
+    std::vector<std::pair<uint32_t, uint32_t>> _enrollments;
+
+    [[nodiscard]] unsigned int numUcs() const;
+
+    [[nodiscard]] std::string ucCode(unsigned int uc) const;
+
+    [[nodiscard]] std::string classCode(unsigned int uc, unsigned int turma) const;
+
+    unsigned int skewedClass();
+
+    void generateLessons();
+
+    void generateStudents();
+
+    bool writeClasses(const std::string &outputDir) const;
+
+    bool writeClassesPerUc(const std::string &outputDir) const;
+
+    bool writeUcs(const std::string &outputDir) const;
+
+    bool writeStudentsClasses(const std::string &outputDir) const;
+
+    bool writeRequests(const std::string &outputDir);
+};
+
+
+#endif //PROJECT_1_SCHEDULE_DATASETGENERATOR_H
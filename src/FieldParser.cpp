@@ -0,0 +1,37 @@
+#include "FieldParser.h"
+#include <charconv>
+#include <cmath>
+
+/**
+ * @brief Converte um campo num inteiro sem sinal, rejeitando campos vazios, com outros caracteres, negativos ou fora
+ * do intervalo de unsigned int (std::stoul lançaria uma exceção ou aceitaria "-5").
+ * Complexidade: O(N), sendo N o comprimento do campo.
+ * @param text - Campo.
+ * @param value - Valor convertido (só é alterado se a conversão for válida).
+ * @return Verdadeiro se o campo é um inteiro sem sinal válido.
+ */
+bool FieldParser::parseUnsigned(const std::string &text, unsigned int &value) {
+    unsigned int parsed;
+    const char *end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, parsed);
+    if (result.ec != std::errc() || result.ptr != end) return false;
+    value = parsed;
+    return true;
+}
+
+/**
+ * @brief Converte um campo num número real, rejeitando campos vazios, com outros caracteres ou não finitos ("inf",
+ * "nan"), em vez de lançar uma exceção como std::stod.
+ * Complexidade: O(N), sendo N o comprimento do campo.
+ * @param text - Campo.
+ * @param value - Valor convertido (só é alterado se a conversão for válida).
+ * @return Verdadeiro se o campo é um número real finito válido.
+ */
+bool FieldParser::parseDouble(const std::string &text, double &value) {
+    double parsed;
+    const char *end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, parsed);
+    if (result.ec != std::errc() || result.ptr != end || !std::isfinite(parsed)) return false;
+    value = parsed;
+    return true;
+}
@@ -0,0 +1,20 @@
+#ifndef PROJECT_1_SCHEDULE_FIELDPARSER_H
+#define PROJECT_1_SCHEDULE_FIELDPARSER_H
+
+
+#include <string>
+
+/**
+ * @brief Funções auxiliares que convertem campos de texto (colunas dos ficheiros CSV ou opções da linha de comandos)
+ * em números sem lançar exceções, para que um valor inválido seja ignorado ou reportado em vez de terminar o programa.
+ */
+
+class FieldParser {
+public:
+    static bool parseUnsigned(const std::string &text, unsigned int &value);
+
+    static bool parseDouble(const std::string &text, double &value);
+};
+
+
+#endif //PROJECT_1_SCHEDULE_FIELDPARSER_H
@@ -0,0 +1,94 @@
+#include "FreeSeatIndex.h"
+#include "MemoryUsage.h"
+#include "UCSpecificClass.h"
+
+/**
+ * @brief Remove todas as turmas do índice.
+ * Complexidade: O(N).
+ */
+void FreeSeatIndex::clear() {
+    _free.clear();
+    _byUc.clear();
+    _byFree.clear();
+}
+
+/**
+ * @brief Define o número de lugares livres de uma turma, acrescentando-a ao índice se ainda não existir.
+ * Complexidade: O(log N).
+ * @param classId - Identificador compacto da turma.
+ * @param freeSeats - Número de lugares livres.
+ */
+void FreeSeatIndex::set(uint32_t classId, unsigned int freeSeats) {
+    uint16_t ucId = UCSpecificClass::ucIdOf(classId);
+    if (_byUc.size() <= ucId) _byUc.resize(ucId + 1);
+    auto it = _free.find(classId);
+    if (it == _free.end()) {
+        it = _free.emplace(classId, freeSeats).first;
+    } else {
+        if (it->second == freeSeats) return;
+        _byUc[ucId].erase({it->second, classId});
+        _byFree.erase({it->second, classId});
+        it->second = freeSeats;
+    }
+    _byUc[ucId].emplace(freeSeats, classId);
+    _byFree.emplace(freeSeats, classId);
+}
+
+/**
+ * @brief Permite obter o número de lugares livres de uma turma.
+ * Complexidade: O(1).
+ * @param classId - Identificador compacto da turma.
+ * @return Número de lugares livres (0 se a turma não estiver no índice).
+ */
+unsigned int FreeSeatIndex::freeSeats(uint32_t classId) const {
+    auto it = _free.find(classId);
+    return it == _free.end() ? 0 : it->second;
+}
+
+/**
+ * @brief Permite obter a turma de uma UC com mais lugares livres.
+ * Complexidade: O(1).
+ * @param ucId - Identificador da UC.
+ * @return Identificador compacto da turma, ou -1 se nenhuma turma da UC tiver lugares livres.
+ */
+int64_t FreeSeatIndex::mostFree(uint16_t ucId) const {
+    if (ucId >= _byUc.size() || _byUc[ucId].empty() || _byUc[ucId].begin()->first == 0) return -1;
+    return _byUc[ucId].begin()->second;
+}
+
+/**
+ * @brief Permite obter as turmas com no máximo 'maximum' lugares livres (incluindo as cheias).
+ * Complexidade: O(log N + K), sendo K o número de turmas devolvidas.
+ * @param maximum - Número máximo de lugares livres.
+ * @return Turmas e lugares livres, por ordem crescente de lugares livres.
+ */
+std::vector<std::pair<uint32_t, unsigned int>> FreeSeatIndex::atMost(unsigned int maximum) const {
+    std::vector<std::pair<uint32_t, unsigned int>> result;
+    for (auto it = _byFree.begin(); it != _byFree.end() && it->first <= maximum; it++) {
+        result.emplace_back(it->second, it->first);
+    }
+    return result;
+}
+
+/**
+ * @brief Permite obter o número de turmas do índice.
+ * Complexidade: O(1).
+ * @return Número de turmas.
+ */
+size_t FreeSeatIndex::size() const {
+    return _free.size();
+}
+
+/**
+ * @brief Estima a memória dinâmica ocupada pelo índice (tabela de dispersão e os dois conjuntos ordenados).
+ * Complexidade: O(U), sendo U o número de UCs.
+ * @return Número de bytes.
+ */
+size_t FreeSeatIndex::memoryUsage() const {
+    size_t entry = sizeof(std::pair<unsigned int, uint32_t>);
+    size_t bytes = _free.size() * MemoryUsage::heapBlock(sizeof(void *) + sizeof(std::pair<const uint32_t, unsigned int>));
+    bytes += MemoryUsage::heapBlock(_free.bucket_count() * sizeof(void *));
+    bytes += MemoryUsage::vectorBuffer(_byUc);
+    bytes += 2 * _free.size() * MemoryUsage::treeNode(entry);
+    return bytes;
+}
@@ -0,0 +1,73 @@
+#ifndef PROJECT_1_SCHEDULE_FREESEATINDEX_H
+#define PROJECT_1_SCHEDULE_FREESEATINDEX_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Índice do número de lugares livres de cada turma (capacidade menos número de alunos, no mínimo 0), mantido
+ * incrementalmente a partir dos identificadores compactos das turmas.
+ * As turmas de cada UC estão num conjunto ordenado por lugares livres (decrescente) e identificador, pelo que obter a
+ * turma de uma UC com mais lugares livres custa O(1) e cada alteração custa O(log N). Um segundo conjunto, com todas
+ * as turmas por ordem crescente de lugares livres, permite obter as turmas quase cheias sem percorrer as outras.
+ */
+
+class FreeSeatIndex {
+public:
+    void clear();
+
+    void set(uint32_t classId, unsigned int freeSeats);
+
+    [[nodiscard]] unsigned int freeSeats(uint32_t classId) const;
+
+    [[nodiscard]] int64_t mostFree(uint16_t ucId) const;
+
+    /**
+     * @brief Permite obter a turma de uma UC com mais lugares livres entre as que cumprem uma condição (por exemplo,
+     * não se sobrepor ao horário de um aluno). As turmas são testadas por ordem decrescente de lugares livres.
+     * Complexidade: O(K * F), sendo K o número de turmas testadas e F o custo da condição.
+     * @param ucId - Identificador da UC.
+     * @param fits - Condição, chamada com o identificador compacto da turma.
+     * @return Identificador compacto da turma, ou -1 se nenhuma turma com lugares livres cumprir a condição.
+     */
+    template<typename Fits>
+    [[nodiscard]] int64_t mostFree(uint16_t ucId, Fits fits) const {
+        if (ucId >= _byUc.size()) return -1;
+        for (const auto &entry: _byUc[ucId]) {
+            if (entry.first == 0) break;
+            if (fits(entry.second)) return entry.second;
+        }
+        return -1;
+    }
+
+    [[nodiscard]] std::vector<std::pair<uint32_t, unsigned int>> atMost(unsigned int maximum) const;
+
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] size_t memoryUsage() const;
+
+private:
+    /**
+     * @brief Ordem das turmas de uma UC: mais lugares livres primeiro e, em caso de empate, menor identificador.
+     */
+    struct MoreFree {
+        bool operator()(const std::pair<unsigned int, uint32_t> &a, const std::pair<unsigned int, uint32_t> &b) const {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        }
+    };
+
+    /** @brief Lugares livres de cada turma. */
+    std::unordered_map<uint32_t, unsigned int> _free;
+    /** @brief Pares (lugares livres, turma) de cada UC (indexado pelo identificador da UC). */
+    std::vector<std::set<std::pair<unsigned int, uint32_t>, MoreFree>> _byUc;
+    /** @brief Pares (lugares livres, turma) de todas as turmas, por ordem crescente. */
+    std::set<std::pair<unsigned int, uint32_t>> _byFree;
+};
+
+
+#endif //PROJECT_1_SCHEDULE_FREESEATINDEX_H
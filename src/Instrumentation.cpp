@@ -0,0 +1,389 @@
+#include "Instrumentation.h"
+
+#ifdef SCHEDULE_INSTRUMENTATION
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    const int REQUEST_TYPES = static_cast<int>(Instrumentation::RequestType::Count);
+    const int OUTCOMES = static_cast<int>(Instrumentation::Outcome::Count);
+    const int PHASES = static_cast<int>(Instrumentation::Phase::Count);
+
+    const char *const REQUEST_TYPE_NAMES[] = {"Cancelamento", "Inscrição", "Alteração de turma", "Alteração de UC"};
+    const char *const OUTCOME_NAMES[] = {"aceites", "conflito", "capacidade", "balanceamento", "inválidos"};
+    const char *const PHASE_NAMES[] = {"Sobreposição", "Capacidade", "Balanceamento", "Escrita do CSV", "Alternativas"};
+
+    /**
+     * @brief Contadores de uma thread. Só a própria thread escreve (load + store relaxados, sem instruções atómicas
+     * de leitura-escrita); o resumo pode lê-los de outra thread sem corridas.
+     */
+    struct Counters {
+        std::atomic<uint64_t> requests[REQUEST_TYPES][OUTCOMES]{};
+        std::atomic<uint64_t> phaseCalls[PHASES]{};
+        std::atomic<uint64_t> phaseNanoseconds[PHASES]{};
+    };
+
+    /**
+     * @brief Escreve um texto alinhado à esquerda numa coluna de largura fixa, contando caracteres UTF-8 e não bytes.
+     */
+    void writeColumn(std::ostream &out, const std::string &text, size_t width) {
+        size_t length = 0;
+        for (char c: text) {
+            if ((c & 0xC0) != 0x80) length++;
+        }
+        out << text << std::string(length < width ? width - length : 1, ' ');
+    }
+
+    void increment(std::atomic<uint64_t> &counter, uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Registo global dos contadores de todas as threads. Os contadores de threads terminadas são somados a
+     * 'retired' para não se perderem.
+     */
+    struct Registry {
+        std::mutex mutex;
+        std::vector<Counters *> threads;
+        Counters retired;
+
+        static Registry &instance() {
+            static Registry registry;
+            return registry;
+        }
+    };
+
+    /**
+     * @brief Histogramas de latência de cada operação, criados na primeira utilização e nunca removidos (as
+     * referências devolvidas ficam sempre válidas).
+     */
+    struct HistogramRegistry {
+        std::mutex mutex;
+        std::map<std::string, std::unique_ptr<LatencyHistogram>> histograms;
+
+        static HistogramRegistry &instance() {
+            static HistogramRegistry registry;
+            return registry;
+        }
+    };
+
+    /** @brief Medição mais interior ativa na thread atual. */
+    thread_local Instrumentation::LatencyScope *innermostScope = nullptr;
+
+    std::string microseconds(uint64_t nanoseconds) {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(1) << nanoseconds / 1e3;
+        return text.str();
+    }
+
+    std::string seconds(uint64_t nanoseconds) {
+        std::ostringstream text;
+        text << std::setprecision(9) << nanoseconds / 1e9;
+        return text.str();
+    }
+
+    /**
+     * @brief Contadores da thread atual, registados na primeira utilização.
+     */
+    struct ThreadSlot {
+        Counters counters;
+
+        ThreadSlot() {
+            Registry &registry = Registry::instance();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.threads.push_back(&counters);
+        }
+
+        ~ThreadSlot() {
+            Registry &registry = Registry::instance();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for (int t = 0; t < REQUEST_TYPES; t++) {
+                for (int o = 0; o < OUTCOMES; o++) {
+                    increment(registry.retired.requests[t][o], counters.requests[t][o].load());
+                }
+            }
+            for (int p = 0; p < PHASES; p++) {
+                increment(registry.retired.phaseCalls[p], counters.phaseCalls[p].load());
+                increment(registry.retired.phaseNanoseconds[p], counters.phaseNanoseconds[p].load());
+            }
+            for (auto it = registry.threads.begin(); it != registry.threads.end(); it++) {
+                if (*it == &counters) {
+                    registry.threads.erase(it);
+                    break;
+                }
+            }
+        }
+    };
+
+    Counters &localCounters() {
+        static thread_local ThreadSlot slot;
+        return slot.counters;
+    }
+}
+
+/**
+ * @brief Construtor da classe ScopedTimer, que começa a contar o tempo.
+ * Complexidade: O(1).
+ * @param phase - Fase cronometrada.
+ */
+Instrumentation::ScopedTimer::ScopedTimer(Phase phase) : _phase(phase), _start(std::chrono::steady_clock::now()) {}
+
+/**
+ * @brief Destrutor da classe ScopedTimer, que soma o tempo decorrido à fase.
+ * Complexidade: O(1).
+ */
+Instrumentation::ScopedTimer::~ScopedTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - _start;
+    addPhaseTime(_phase, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+/**
+ * @brief Construtor da classe LatencyScope, que começa a medir.
+ * Complexidade: O(1).
+ * @param histogram - Histograma da operação.
+ */
+Instrumentation::LatencyScope::LatencyScope(LatencyHistogram &histogram)
+        : _histogram(histogram), _start(std::chrono::steady_clock::now()), _parent(innermostScope) {
+    innermostScope = this;
+}
+
+/**
+ * @brief Destrutor da classe LatencyScope, que regista a medição caso ainda não tenha sido registada.
+ * Complexidade: O(1).
+ */
+Instrumentation::LatencyScope::~LatencyScope() {
+    stop();
+    innermostScope = _parent;
+}
+
+/**
+ * @brief Suspende a medição (por exemplo, enquanto se espera por input do utilizador).
+ * Complexidade: O(1).
+ */
+void Instrumentation::LatencyScope::pause() {
+    if (!_running) return;
+    _elapsed += std::chrono::steady_clock::now() - _start;
+    _running = false;
+}
+
+/**
+ * @brief Retoma uma medição suspensa.
+ * Complexidade: O(1).
+ */
+void Instrumentation::LatencyScope::resume() {
+    if (_running || _stopped) return;
+    _start = std::chrono::steady_clock::now();
+    _running = true;
+}
+
+/**
+ * @brief Termina a medição e regista-a no histograma. Chamadas seguintes não têm efeito.
+ * Complexidade: O(1).
+ */
+void Instrumentation::LatencyScope::stop() {
+    if (_stopped) return;
+    pause();
+    _stopped = true;
+    _histogram.record(std::chrono::duration_cast<std::chrono::nanoseconds>(_elapsed).count());
+}
+
+/**
+ * @brief Suspende todas as medições ativas na thread atual.
+ * Complexidade: O(P), sendo P a profundidade de operações encaixadas.
+ */
+void Instrumentation::LatencyScope::pauseAll() {
+    for (LatencyScope *scope = innermostScope; scope != nullptr; scope = scope->_parent) scope->pause();
+}
+
+/**
+ * @brief Retoma todas as medições ativas na thread atual.
+ * Complexidade: O(P), sendo P a profundidade de operações encaixadas.
+ */
+void Instrumentation::LatencyScope::resumeAll() {
+    for (LatencyScope *scope = innermostScope; scope != nullptr; scope = scope->_parent) scope->resume();
+}
+
+/**
+ * @brief Regista o resultado do processamento de um pedido.
+ * Complexidade: O(1).
+ * @param type - Tipo de pedido.
+ * @param outcome - Resultado.
+ */
+void Instrumentation::countRequest(RequestType type, Outcome outcome) {
+    increment(localCounters().requests[static_cast<int>(type)][static_cast<int>(outcome)], 1);
+}
+
+/**
+ * @brief Soma tempo a uma fase.
+ * Complexidade: O(1).
+ * @param phase - Fase.
+ * @param nanoseconds - Tempo decorrido, em nanossegundos.
+ */
+void Instrumentation::addPhaseTime(Phase phase, uint64_t nanoseconds) {
+    Counters &counters = localCounters();
+    increment(counters.phaseCalls[static_cast<int>(phase)], 1);
+    increment(counters.phaseNanoseconds[static_cast<int>(phase)], nanoseconds);
+}
+
+/**
+ * @brief Mostra o resumo dos contadores de todas as threads.
+ * Complexidade: O(T), sendo T o número de threads.
+ * @param out - Stream onde escrever o resumo.
+ */
+void Instrumentation::printSummary(std::ostream &out) {
+    Registry &registry = Registry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<Counters *> all = registry.threads;
+    all.push_back(&registry.retired);
+
+    out << "----------------- Instrumentação -----------------" << std::endl;
+    writeColumn(out, "Pedido", 22);
+    for (const char *outcome: OUTCOME_NAMES) writeColumn(out, outcome, 15);
+    out << std::endl;
+    for (int t = 0; t < REQUEST_TYPES; t++) {
+        writeColumn(out, REQUEST_TYPE_NAMES[t], 22);
+        for (int o = 0; o < OUTCOMES; o++) {
+            uint64_t total = 0;
+            for (Counters *counters: all) total += counters->requests[t][o].load(std::memory_order_relaxed);
+            writeColumn(out, std::to_string(total), 15);
+        }
+        out << std::endl;
+    }
+    out << std::endl;
+    writeColumn(out, "Fase", 22);
+    writeColumn(out, "chamadas", 15);
+    writeColumn(out, "total (ms)", 15);
+    out << "média (us)" << std::endl;
+    for (int p = 0; p < PHASES; p++) {
+        uint64_t calls = 0, nanoseconds = 0;
+        for (Counters *counters: all) {
+            calls += counters->phaseCalls[p].load(std::memory_order_relaxed);
+            nanoseconds += counters->phaseNanoseconds[p].load(std::memory_order_relaxed);
+        }
+        std::ostringstream total, average;
+        total << std::fixed << std::setprecision(3) << nanoseconds / 1e6;
+        average << std::fixed << std::setprecision(3) << (calls ? nanoseconds / 1e3 / calls : 0.0);
+        writeColumn(out, PHASE_NAMES[p], 22);
+        writeColumn(out, std::to_string(calls), 15);
+        writeColumn(out, total.str(), 15);
+        out << average.str() << std::endl;
+    }
+
+    HistogramRegistry &histograms = HistogramRegistry::instance();
+    std::lock_guard<std::mutex> histogramsLock(histograms.mutex);
+    if (!histograms.histograms.empty()) {
+        out << std::endl;
+        writeColumn(out, "Operação", 30);
+        for (const char *column: {"n", "p50 (us)", "p90 (us)", "p99 (us)"}) writeColumn(out, column, 12);
+        out << "máx (us)" << std::endl;
+        for (const auto &it: histograms.histograms) {
+            const LatencyHistogram &histogram = *it.second;
+            writeColumn(out, it.first, 30);
+            writeColumn(out, std::to_string(histogram.getCount()), 12);
+            writeColumn(out, microseconds(histogram.percentile(0.5)), 12);
+            writeColumn(out, microseconds(histogram.percentile(0.9)), 12);
+            writeColumn(out, microseconds(histogram.percentile(0.99)), 12);
+            out << microseconds(histogram.getMax()) << std::endl;
+        }
+    }
+    out << "--------------------------------------------------" << std::endl;
+}
+
+/**
+ * @brief Coloca todos os contadores a zero (os histogramas de latência são mantidos entre lotes).
+ * Complexidade: O(T), sendo T o número de threads.
+ */
+void Instrumentation::reset() {
+    Registry &registry = Registry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<Counters *> all = registry.threads;
+    all.push_back(&registry.retired);
+    for (Counters *counters: all) {
+        for (auto &type: counters->requests) {
+            for (auto &counter: type) counter.store(0, std::memory_order_relaxed);
+        }
+        for (auto &counter: counters->phaseCalls) counter.store(0, std::memory_order_relaxed);
+        for (auto &counter: counters->phaseNanoseconds) counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Permite obter o histograma de latências de uma operação, criando-o se necessário.
+ * Complexidade: O(log N), sendo N o número de operações.
+ * @param operation - Nome da operação.
+ * @return Histograma da operação.
+ */
+LatencyHistogram &Instrumentation::histogram(const std::string &operation) {
+    HistogramRegistry &registry = HistogramRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::unique_ptr<LatencyHistogram> &histogram = registry.histograms[operation];
+    if (!histogram) histogram = std::make_unique<LatencyHistogram>();
+    return *histogram;
+}
+
+/**
+ * @brief Exporta os histogramas de latência para um ficheiro: em JSON se a extensão for ".json" (com percentis e
+ * baldes não vazios), caso contrário no formato de texto do Prometheus (um "summary" por operação).
+ * Complexidade: O(N*B), sendo N o número de operações e B o número de baldes.
+ * @param file - Ficheiro de destino.
+ * @return Verdadeiro se o ficheiro foi escrito, falso caso contrário.
+ */
+bool Instrumentation::exportHistograms(const std::string &file) {
+    HistogramRegistry &registry = HistogramRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::ofstream out(file);
+    const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+    bool json = file.size() >= 5 && file.compare(file.size() - 5, 5, ".json") == 0;
+
+    if (json) {
+        out << "{\"unit\": \"ns\", \"operations\": [";
+        bool first = true;
+        for (const auto &it: registry.histograms) {
+            const LatencyHistogram &histogram = *it.second;
+            out << (first ? "" : ",") << "\n  {\"name\": \"" << it.first << "\", \"count\": " << histogram.getCount()
+                << ", \"sum\": " << histogram.getSum() << ", \"min\": " << histogram.getMin()
+                << ", \"max\": " << histogram.getMax();
+            for (double quantile: quantiles) {
+                std::ostringstream name;
+                name << "p" << quantile * 100;
+                std::string key = name.str();
+                key.erase(std::remove(key.begin(), key.end(), '.'), key.end());
+                out << ", \"" << key << "\": " << histogram.percentile(quantile);
+            }
+            out << ", \"buckets\": [";
+            bool firstBucket = true;
+            for (const auto &bucket: histogram.nonEmptyBuckets()) {
+                out << (firstBucket ? "" : ", ") << "[" << bucket.first << ", " << bucket.second << "]";
+                firstBucket = false;
+            }
+            out << "]}";
+            first = false;
+        }
+        out << "\n]}\n";
+    } else {
+        out << "# HELP schedule_operation_latency_seconds Latência das operações do ScheduleManager.\n";
+        out << "# TYPE schedule_operation_latency_seconds summary\n";
+        for (const auto &it: registry.histograms) {
+            const LatencyHistogram &histogram = *it.second;
+            std::string label = "operation=\"" + it.first + "\"";
+            for (double quantile: quantiles) {
+                out << "schedule_operation_latency_seconds{" << label << ",quantile=\"" << quantile << "\"} "
+                    << seconds(histogram.percentile(quantile)) << "\n";
+            }
+            out << "schedule_operation_latency_seconds_sum{" << label << "} " << seconds(histogram.getSum()) << "\n";
+            out << "schedule_operation_latency_seconds_count{" << label << "} " << histogram.getCount() << "\n";
+        }
+    }
+    return out.good();
+}
+
+#endif
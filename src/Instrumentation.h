@@ -0,0 +1,127 @@
+#ifndef PROJECT_1_SCHEDULE_INSTRUMENTATION_H
+#define PROJECT_1_SCHEDULE_INSTRUMENTATION_H
+
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include "LatencyHistogram.h"
+
+/**
+ * @brief Classe que recolhe contadores e tempos do processamento de pedidos (tipos de pedido, razões de recusa e
+ * tempo gasto nas verificações de sobreposição, capacidade e balanceamento e na escrita do CSV).
+ * Cada thread escreve nos seus próprios contadores; o resumo soma os contadores de todas as threads.
+ * Guarda também um histograma de latências por operação pública do ScheduleManager, exportável em JSON ou no formato
+ * de texto do Prometheus. Só as operações pedidas pelo utilizador e os processadores de pedidos são medidos; as
+ * pesquisas auxiliares (findStudent, findClass, ...) chamadas dentro delas não, para não inflacionar os tempos.
+ * Só é compilada quando SCHEDULE_INSTRUMENTATION está definido; caso contrário as macros não geram código.
+ */
+
+class Instrumentation {
+public:
+    /** @brief Tipos de pedido. */
+    enum class RequestType { Removal, Enrollment, ChangeClass, ChangeUc, Count };
+
+    /** @brief Resultado do processamento de um pedido. */
+    enum class Outcome { Accepted, Conflict, Capacity, Balance, Invalid, Count };
+
+    /** @brief Fases cronometradas. */
+    enum class Phase { OverlapCheck, CapacityCheck, BalanceCheck, Persistence, Suggestions, Count };
+
+#ifdef SCHEDULE_INSTRUMENTATION
+
+    /**
+     * @brief Cronómetro que soma à fase indicada o tempo decorrido entre a sua criação e destruição.
+     */
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Phase phase);
+
+        ~ScopedTimer();
+
+    private:
+        /** @brief Fase cronometrada. */
+        Phase _phase;
+        /** @brief Instante de início. */
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    /**
+     * @brief Mede a latência de uma operação e regista-a num histograma quando é parado ou destruído.
+     * As medições ativas da thread podem ser pausadas em conjunto enquanto se espera pelo utilizador.
+     */
+    class LatencyScope {
+    public:
+        explicit LatencyScope(LatencyHistogram &histogram);
+
+        ~LatencyScope();
+
+        void pause();
+
+        void resume();
+
+        void stop();
+
+        static void pauseAll();
+
+        static void resumeAll();
+
+    private:
+        /** @brief Histograma da operação. */
+        LatencyHistogram &_histogram;
+        /** @brief Instante em que a medição foi (re)iniciada. */
+        std::chrono::steady_clock::time_point _start;
+        /** @brief Tempo acumulado antes da última pausa. */
+        std::chrono::steady_clock::duration _elapsed{};
+        /** @brief Indica se a medição está a decorrer. */
+        bool _running = true;
+        /** @brief Indica se a medição já foi registada. */
+        bool _stopped = false;
+        /** @brief Medição da operação que chamou esta (operações encaixadas), ou nullptr. */
+        LatencyScope *_parent;
+    };
+
+    static void countRequest(RequestType type, Outcome outcome);
+
+    static void addPhaseTime(Phase phase, uint64_t nanoseconds);
+
+    static void printSummary(std::ostream &out);
+
+    static void reset();
+
+    static LatencyHistogram &histogram(const std::string &operation);
+
+    static bool exportHistograms(const std::string &file);
+
+#endif
+};
+
+#ifdef SCHEDULE_INSTRUMENTATION
+#define SCHEDULE_CONCAT_IMPL(a, b) a##b
+#define SCHEDULE_CONCAT(a, b) SCHEDULE_CONCAT_IMPL(a, b)
+#define SCHEDULE_COUNT_REQUEST(type, outcome) \
+    Instrumentation::countRequest(Instrumentation::RequestType::type, Instrumentation::Outcome::outcome)
+#define SCHEDULE_TIME_PHASE(phase) \
+    Instrumentation::ScopedTimer SCHEDULE_CONCAT(_scheduleTimer, __LINE__)(Instrumentation::Phase::phase)
+#define SCHEDULE_PRINT_SUMMARY(out) Instrumentation::printSummary(out)
+#define SCHEDULE_RESET_SUMMARY() Instrumentation::reset()
+#define SCHEDULE_LATENCY() \
+    static LatencyHistogram &_scheduleHistogram = Instrumentation::histogram(__func__); \
+    Instrumentation::LatencyScope _scheduleLatency(_scheduleHistogram)
+#define SCHEDULE_LATENCY_PAUSE() Instrumentation::LatencyScope::pauseAll()
+#define SCHEDULE_LATENCY_RESUME() Instrumentation::LatencyScope::resumeAll()
+#define SCHEDULE_LATENCY_STOP() _scheduleLatency.stop()
+#else
+#define SCHEDULE_COUNT_REQUEST(type, outcome) ((void) 0)
+#define SCHEDULE_TIME_PHASE(phase) ((void) 0)
+#define SCHEDULE_PRINT_SUMMARY(out) ((void) 0)
+#define SCHEDULE_RESET_SUMMARY() ((void) 0)
+#define SCHEDULE_LATENCY() ((void) 0)
+#define SCHEDULE_LATENCY_PAUSE() ((void) 0)
+#define SCHEDULE_LATENCY_RESUME() ((void) 0)
+#define SCHEDULE_LATENCY_STOP() ((void) 0)
+#endif
+
+
+#endif //PROJECT_1_SCHEDULE_INSTRUMENTATION_H
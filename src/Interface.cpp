@@ -1,4 +1,6 @@
 #include "Interface.h"
+#include "Instrumentation.h"
+#include "Tracer.h"
 
 /**
  * @brief Construtor default da classe Interface.
@@ -9,11 +11,28 @@ ScheduleManager Interface::_scheduleManager;
 
 /**
  * @brief Permite correr o programa.
+ * Se a variável de ambiente SCHEDULE_HISTOGRAMS estiver definida, as latências são exportadas para esse ficheiro à
+ * saída.
+ * Se SCHEDULE_TRACE estiver definida, é gravado nesse ficheiro um registo trace_event (Chrome/Perfetto) da execução.
+ * As listagens longas são escritas no ficheiro indicado em SCHEDULE_LISTING, se estiver definida, ou mostradas com o
+ * paginador indicado em SCHEDULE_PAGER (por exemplo "less").
  */
 void Interface::run() {
+#ifdef SCHEDULE_INSTRUMENTATION
+    if (getenv("SCHEDULE_TRACE") != nullptr) Tracer::start(getenv("SCHEDULE_TRACE"));
+#endif
+    if (getenv("SCHEDULE_PAGER") != nullptr) _scheduleManager.setPager(getenv("SCHEDULE_PAGER"));
+    if (getenv("SCHEDULE_LISTING") != nullptr && !_scheduleManager.setListingFile(getenv("SCHEDULE_LISTING"))) {
+        std::cerr << "Não foi possível abrir " << getenv("SCHEDULE_LISTING") << std::endl;
+    }
     system("clear");
-    _scheduleManager.load_classes("../schedule/classes.csv");
-    _scheduleManager.load_students_classes("../schedule/students_classes.csv");
+    {
+        SCHEDULE_TRACE_SPAN("Arranque");
+        _scheduleManager.load_classes("../schedule/classes.csv");
+        _scheduleManager.load_students_classes("../schedule/students_classes.csv");
+        _scheduleManager.load_capacities("../schedule/capacities.csv");
+        _scheduleManager.load_ucs("../schedule/ucs.csv");
+    }
     bool running = true;
 
     while (running) {
@@ -29,6 +48,10 @@ void Interface::run() {
                 break;
 
             case 9:
+                if (getenv("SCHEDULE_HISTOGRAMS") != nullptr) exportHistograms(getenv("SCHEDULE_HISTOGRAMS"));
+#ifdef SCHEDULE_INSTRUMENTATION
+                Tracer::finish();
+#endif
                 std::cout << "Obrigado pela sua preferência!" << std::endl;
                 std::cout << "Prima Enter para terminar.";
                 std::cin.ignore();
@@ -47,6 +70,159 @@ void Interface::run() {
     }
 }
 
+/**
+ * @brief Permite correr o programa sem interação, processando um ficheiro de pedidos.
+ * Opções: --data <pasta> (ficheiros CSV do horário; capacities.csv é opcional),
+ * --requests <ficheiro> (pedidos a processar),
+ * --output <ficheiro> (CSV onde guardar as turmas dos estudantes; sem esta opção nada é escrito),
+ * --histograms <ficheiro> (exporta as latências por operação, em JSON se terminar em ".json" ou em formato Prometheus),
+ * --trace <ficheiro> (grava um registo trace_event do arranque e do processamento, para o Perfetto),
+ * --memory (mostra a memória estimada de cada estrutura depois de carregar os dados e depois do processamento),
+ * --listing <ficheiro> (escreve a lista de pedidos recusados nesse ficheiro em vez do terminal),
+ * --cohort <ficheiro> (inscreve em bloco os alunos e UCs do ficheiro, antes de processar os pedidos),
+ * --rebalance (no fim, equilibra as turmas das UCs cujo desvio padrão ficou acima do limite),
+ * --heatmap <ficheiro> (no fim, exporta em CSV o número de alunos em aula em cada meia hora da semana),
+ * --coenrollment <ficheiro> (no fim, exporta em CSV o número de alunos inscritos em cada par de UCs).
+ * @param args Argumentos da linha de comandos.
+ * @return Código de saída do programa.
+ */
+int Interface::runBatch(const std::vector<std::string> &args) {
+    std::string dataDir = "../schedule", requestsFile, outputFile, histogramsFile, traceFile, listingFile, cohortFile,
+            heatmapFile, coEnrollmentFile;
+    bool memoryReport = false, rebalance = false;
+    for (size_t i = 0; i < args.size(); i++) {
+        if (args[i] == "--data" && i + 1 < args.size()) {
+            dataDir = args[++i];
+        } else if (args[i] == "--requests" && i + 1 < args.size()) {
+            requestsFile = args[++i];
+        } else if (args[i] == "--output" && i + 1 < args.size()) {
+            outputFile = args[++i];
+        } else if (args[i] == "--histograms" && i + 1 < args.size()) {
+            histogramsFile = args[++i];
+        } else if (args[i] == "--trace" && i + 1 < args.size()) {
+            traceFile = args[++i];
+        } else if (args[i] == "--listing" && i + 1 < args.size()) {
+            listingFile = args[++i];
+        } else if (args[i] == "--cohort" && i + 1 < args.size()) {
+            cohortFile = args[++i];
+        } else if (args[i] == "--heatmap" && i + 1 < args.size()) {
+            heatmapFile = args[++i];
+        } else if (args[i] == "--coenrollment" && i + 1 < args.size()) {
+            coEnrollmentFile = args[++i];
+        } else if (args[i] == "--memory") {
+            memoryReport = true;
+        } else if (args[i] == "--rebalance") {
+            rebalance = true;
+        } else {
+            std::cerr << "Utilização: project_1_schedule [--data <pasta>] [--requests <ficheiro>] [--output <ficheiro>]"
+                      << " [--histograms <ficheiro>] [--trace <ficheiro>] [--memory] [--listing <ficheiro>]"
+                      << " [--cohort <ficheiro>] [--rebalance] [--heatmap <ficheiro>]"
+                      << " [--coenrollment <ficheiro>]" << std::endl;
+            return 1;
+        }
+    }
+    if (!_scheduleManager.setListingFile(listingFile)) {
+        std::cerr << "Não foi possível abrir " << listingFile << std::endl;
+        return 1;
+    }
+    if (!traceFile.empty()) {
+#ifdef SCHEDULE_INSTRUMENTATION
+        Tracer::start(traceFile);
+#else
+        std::cerr << "Instrumentação desativada (compilar com -DSCHEDULE_INSTRUMENTATION=ON)." << std::endl;
+        return 1;
+#endif
+    }
+
+    {
+        SCHEDULE_TRACE_SPAN("Arranque");
+        _scheduleManager.load_classes(dataDir + "/classes.csv");
+        _scheduleManager.load_students_classes(dataDir + "/students_classes.csv");
+        _scheduleManager.load_capacities(dataDir + "/capacities.csv");
+        _scheduleManager.load_ucs(dataDir + "/ucs.csv");
+    }
+    // Uma exportação que falhe não impede a gravação do registo de eventos e dos histogramas em finishBatch().
+    int status = 0;
+    if (requestsFile.empty() && cohortFile.empty() && !rebalance) {
+        if (!heatmapFile.empty() && !_scheduleManager.exportOccupancyHeatmap(heatmapFile)) {
+            std::cerr << "Não foi possível escrever " << heatmapFile << std::endl;
+            status = 1;
+        }
+        if (!coEnrollmentFile.empty() && !_scheduleManager.exportCoEnrollment(coEnrollmentFile)) {
+            std::cerr << "Não foi possível escrever " << coEnrollmentFile << std::endl;
+            status = 1;
+        }
+        if (memoryReport) _scheduleManager.printMemoryReport(std::cout);
+        int finished = finishBatch(histogramsFile);
+        return status != 0 ? status : finished;
+    }
+
+    if (!cohortFile.empty()) _scheduleManager.enrollCohort(cohortFile);
+    if (!requestsFile.empty()) {
+        unsigned int loaded = _scheduleManager.load_requests(requestsFile);
+        std::cout << "Pedidos carregados: " << loaded << std::endl;
+        if (memoryReport) _scheduleManager.printMemoryReport(std::cout);
+        SCHEDULE_RESET_SUMMARY();
+        _scheduleManager.processPendingRequests();
+        _scheduleManager.printRejectedRequests();
+    }
+    if (rebalance) _scheduleManager.rebalanceClasses();
+    if (!heatmapFile.empty() && !_scheduleManager.exportOccupancyHeatmap(heatmapFile)) {
+        std::cerr << "Não foi possível escrever " << heatmapFile << std::endl;
+        status = 1;
+    }
+    if (!coEnrollmentFile.empty() && !_scheduleManager.exportCoEnrollment(coEnrollmentFile)) {
+        std::cerr << "Não foi possível escrever " << coEnrollmentFile << std::endl;
+        status = 1;
+    }
+
+    if (!outputFile.empty()) {
+        _scheduleManager.setStudentsClassesFile(outputFile);
+        _scheduleManager.UpdateStudentsClassesCSV();
+    }
+    SCHEDULE_PRINT_SUMMARY(std::cout);
+    if (memoryReport) _scheduleManager.printMemoryReport(std::cout);
+    int finished = finishBatch(histogramsFile);
+    return status != 0 ? status : finished;
+}
+
+/**
+ * @brief Termina o modo não interativo, gravando o registo de eventos e os histogramas pedidos. Os histogramas são
+ * exportados mesmo que a escrita do registo de eventos falhe.
+ * @param histogramsFile Ficheiro dos histogramas (vazio para não exportar).
+ * @return Código de saída do programa.
+ */
+int Interface::finishBatch(const std::string &histogramsFile) {
+    int status = 0;
+#ifdef SCHEDULE_INSTRUMENTATION
+    if (!Tracer::finish()) {
+        std::cerr << "Não foi possível escrever o registo de eventos." << std::endl;
+        status = 1;
+    }
+#endif
+    int exported = exportHistograms(histogramsFile);
+    return status != 0 ? status : exported;
+}
+
+/**
+ * @brief Exporta os histogramas de latência, se tiver sido pedido um ficheiro.
+ * @param file Ficheiro de destino (vazio para não exportar).
+ * @return Código de saída do programa.
+ */
+int Interface::exportHistograms(const std::string &file) {
+    if (file.empty()) return 0;
+#ifdef SCHEDULE_INSTRUMENTATION
+    if (!Instrumentation::exportHistograms(file)) {
+        std::cerr << "Não foi possível escrever " << file << std::endl;
+        return 1;
+    }
+    return 0;
+#else
+    std::cerr << "Instrumentação desativada (compilar com -DSCHEDULE_INSTRUMENTATION=ON)." << std::endl;
+    return 1;
+#endif
+}
+
 /**
  * @brief Permite mostrar o menu principal.
  * @return Número correspondente à ação que o utilizador pretende realizar.
@@ -133,6 +309,7 @@ void Interface::studentInfoMenu() {
         std::cout << "1. Horário de um aluno." << std::endl;
         std::cout << "2. Lista e número de alunos num dado ano." << std::endl;
         std::cout << "3. Número de alunos inscritos em pelo menos 'n' unidades curriculares." << std::endl;
+        std::cout << "4. Horários livres comuns a um grupo de alunos." << std::endl;
         std::cout << "9. Sair." << std::endl;
         std::cout << ">>> ";
         std::cin >> num_aux;
@@ -158,6 +335,19 @@ void Interface::studentInfoMenu() {
                 studenMenuRunning = false;
                 break;
 
+            case 4: {
+                std::vector<unsigned int> group;
+                float hours;
+                std::cout << "Insira os números UP dos alunos (0 para terminar)." << std::endl;
+                while (std::cout << ">>> " && std::cin >> studentCode && studentCode != 0) group.push_back(studentCode);
+                std::cout << "Insira a duração mínima, em horas." << std::endl;
+                std::cout << ">>> ";
+                std::cin >> hours;
+                _scheduleManager.displayCommonFreeTime(group, hours);
+                studenMenuRunning = false;
+                break;
+            }
+
             case 9:
                 studenMenuRunning = false;
                 break;
@@ -185,6 +375,9 @@ void Interface::classInfoMenu() {
         std::cout << "-------------------- Informações sobre as turmas --------------------" << std::endl;
         std::cout << "1. Horário de uma turma." << std::endl;
         std::cout << "2. Lista e número de estudantes de uma turma." << std::endl;
+        std::cout << "3. Ocupação das turmas e unidades curriculares." << std::endl;
+        std::cout << "4. Horários livres comuns aos alunos de uma turma." << std::endl;
+        std::cout << "5. Mapa de ocupação semanal (alunos em aula por meia hora)." << std::endl;
         std::cout << "9. Sair." << std::endl;
         std::cout << ">>> ";
         std::cin >> num_aux;
@@ -204,6 +397,56 @@ void Interface::classInfoMenu() {
                 classMenuRunning = false;
                 break;
 
+            case 3:
+                unsigned int top, margin;
+                std::cout << "Insira o número de turmas e unidades curriculares a mostrar." << std::endl;
+                std::cout << ">>> ";
+                std::cin >> top;
+                std::cout << "Insira o número máximo de lugares livres de uma turma perto da capacidade."
+                          << std::endl;
+                std::cout << ">>> ";
+                std::cin >> margin;
+                _scheduleManager.displayOccupancy(top, margin);
+                classMenuRunning = false;
+                break;
+
+            case 4: {
+                year = _scheduleManager.displayClassesYears();
+                classCode = _scheduleManager.displaySomeClasses(year);
+                ucCode = ScheduleManager::displaySomeUcs(year);
+                Class *turma = _scheduleManager.findClass(UCSpecificClass(classCode, ucCode));
+                if (turma == nullptr) {
+                    std::cout << "Turma não encontrada." << std::endl;
+                    classMenuRunning = false;
+                    break;
+                }
+                float hours;
+                std::cout << "Insira a duração mínima, em horas." << std::endl;
+                std::cout << ">>> ";
+                std::cin >> hours;
+                const Roster &roster = turma->getStudentsIDs();
+                _scheduleManager.displayCommonFreeTime(std::vector<unsigned int>(roster.begin(), roster.end()), hours);
+                classMenuRunning = false;
+                break;
+            }
+
+            case 5: {
+                std::string lessonType;
+                std::cout << "Insira o ano (0 para todos)." << std::endl;
+                std::cout << ">>> ";
+                std::cin >> year;
+                std::cout << "Insira o código da UC (- para todas)." << std::endl;
+                std::cout << ">>> ";
+                std::cin >> ucCode;
+                std::cout << "Insira o tipo de aula, T, TP ou PL (- para todos)." << std::endl;
+                std::cout << ">>> ";
+                std::cin >> lessonType;
+                _scheduleManager.displayOccupancyHeatmap(year == '0' ? 0 : year, ucCode == "-" ? "" : ucCode,
+                                                         lessonType == "-" ? "" : lessonType);
+                classMenuRunning = false;
+                break;
+            }
+
             case 9:
                 classMenuRunning = false;
                 break;
@@ -232,6 +475,7 @@ void Interface::curriculumInfoMenu() {
         std::cout << "1. Lista e número de estudantes de uma unidade curricular." << std::endl;
         std::cout << "2. Unidade curricular com maior número de alunos." << std::endl;
         std::cout << "3. Horário de uma unidade curricular." << std::endl;
+        std::cout << "4. Alunos em comum com outras unidades curriculares." << std::endl;
         std::cout << "9. Sair." << std::endl;
         std::cout << ">>> ";
         std::cin >> num_aux;
@@ -256,6 +500,12 @@ void Interface::curriculumInfoMenu() {
                 curriculumMenuRunning = false;
                 break;
 
+            case 4:
+                ucCode = _scheduleManager.displayAllUcs();
+                _scheduleManager.displayCoEnrollment(ucCode);
+                curriculumMenuRunning = false;
+                break;
+
             case 9:
                 curriculumMenuRunning = false;
                 break;
@@ -298,6 +548,27 @@ void Interface::pedidos() {
                 _scheduleManager.undoLastRequest();
                 break;
 
+            case 5:
+                system("clear");
+#ifdef SCHEDULE_INSTRUMENTATION
+                Instrumentation::printSummary(std::cout);
+#else
+                std::cout << "Instrumentação desativada (compilar com -DSCHEDULE_INSTRUMENTATION=ON)." << std::endl;
+#endif
+                std::cout << "Prima Enter para continuar.";
+                std::cin.ignore();
+                std::cin.get();
+                break;
+
+            case 6:
+                system("clear");
+                _scheduleManager.rebalanceClasses();
+                _scheduleManager.UpdateStudentsClassesCSV();
+                std::cout << "Prima Enter para continuar.";
+                std::cin.ignore();
+                std::cin.get();
+                break;
+
             case 9:
                 system("clear");
                 running = false;
@@ -326,10 +597,12 @@ int Interface::displayPedidosMenu() {
         std::cout << "2. Ver pedidos pendentes." << std::endl;
         std::cout << "3. Processar pedidos." << std::endl;
         std::cout << "4. Anular último pedido." << std::endl;
+        std::cout << "5. Estatísticas do último processamento." << std::endl;
+        std::cout << "6. Rebalancear turmas." << std::endl;
         std::cout << "9. Sair." << std::endl;
         std::cout << ">>> ";
         std::cin >> num_action;
-        if ((num_action >= 1 && num_action <= 4) || num_action == 9) {
+        if ((num_action >= 1 && num_action <= 6) || num_action == 9) {
             return num_action;
         }
         else {
@@ -351,10 +624,11 @@ int Interface::newRequestMenu() {
         std::cout << "2. Trocar de Uc." << std::endl;
         std::cout << "3. Inscrição numa nova UC." << std::endl;
         std::cout << "4. Cancelar inscrição numa UC." << std::endl;
+        std::cout << "5. Gerar horário a partir de uma lista de UCs." << std::endl;
         std::cout << "9. Sair" << std::endl;
         std::cout << ">>> ";
         std::cin >> num_action;
-        if (num_action >= 1 && num_action <= 4) {
+        if (num_action >= 1 && num_action <= 5) {
             return num_action;
         }
         else if (num_action == 9) {
@@ -405,6 +679,9 @@ void Interface::SubmitNewRequestsMenu(int num_action) {
         case 4:
             _scheduleManager.SubmitRemovalRequest(student);
             break;
+        case 5:
+            _scheduleManager.SubmitTimetableRequest(student);
+            break;
         default:
             std::cout << "Por favor, introduza um dígito válido." << std::endl;
             std::cout << "Prima Enter para continuar.";
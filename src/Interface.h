@@ -4,6 +4,7 @@
 
 #include "ScheduleManager.h"
 #include <iostream>
+#include <vector>
 
 /**
  * @brief Classe que permite interagir com o utilizador.
@@ -15,6 +16,8 @@ public:
 
     static void run();
 
+    static int runBatch(const std::vector<std::string> &args);
+
 private:
     /** @brief Objeto que permite obter informações dos horários (seja turma ou uc), dos pedidos e dos estudantes. */
     static ScheduleManager _scheduleManager;
@@ -38,6 +41,10 @@ private:
     static int newRequestMenu();
 
     static void SubmitNewRequestsMenu(int num_action);
+
+    static int exportHistograms(const std::string &file);
+
+    static int finishBatch(const std::string &histogramsFile);
 };
 
 
@@ -0,0 +1,142 @@
+#include "LatencyHistogram.h"
+
+#include <limits>
+
+/**
+ * @brief Construtor da classe LatencyHistogram.
+ * Complexidade: O(B), sendo B o número de baldes.
+ */
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+/**
+ * @brief Regista uma medição.
+ * Complexidade: O(1).
+ * @param nanoseconds - Latência medida, em nanossegundos.
+ */
+void LatencyHistogram::record(uint64_t nanoseconds) {
+    _buckets[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+    uint64_t current = _min.load(std::memory_order_relaxed);
+    while (nanoseconds < current && !_min.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {}
+    current = _max.load(std::memory_order_relaxed);
+    while (nanoseconds > current && !_max.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {}
+}
+
+/**
+ * @brief Permite obter o número de medições.
+ * Complexidade: O(1).
+ * @return Número de medições.
+ */
+uint64_t LatencyHistogram::getCount() const {
+    return _count.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Permite obter a soma de todas as medições.
+ * Complexidade: O(1).
+ * @return Soma das medições, em nanossegundos.
+ */
+uint64_t LatencyHistogram::getSum() const {
+    return _sum.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Permite obter a menor medição.
+ * Complexidade: O(1).
+ * @return Menor medição, em nanossegundos (0 se não houver medições).
+ */
+uint64_t LatencyHistogram::getMin() const {
+    return getCount() == 0 ? 0 : _min.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Permite obter a maior medição.
+ * Complexidade: O(1).
+ * @return Maior medição, em nanossegundos.
+ */
+uint64_t LatencyHistogram::getMax() const {
+    return _max.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Calcula um percentil, devolvendo o limite superior do balde onde este se encontra (limitado ao máximo).
+ * Complexidade: O(B), sendo B o número de baldes.
+ * @param quantile - Quantil desejado, entre 0 e 1 (por exemplo 0.99 para o p99).
+ * @return Latência do percentil, em nanossegundos.
+ */
+uint64_t LatencyHistogram::percentile(double quantile) const {
+    uint64_t count = getCount();
+    if (count == 0) return 0;
+    auto target = static_cast<uint64_t>(quantile * (double) count + 0.5);
+    if (target == 0) target = 1;
+    uint64_t seen = 0;
+    for (unsigned int i = 0; i < BUCKETS; i++) {
+        seen += _buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            uint64_t upper = bucketUpperBound(i);
+            return upper < getMax() ? upper : getMax();
+        }
+    }
+    return getMax();
+}
+
+/**
+ * @brief Permite obter os baldes com medições.
+ * Complexidade: O(B), sendo B o número de baldes.
+ * @return Vetor de pares (limite superior do balde em nanossegundos, número de medições).
+ */
+std::vector<std::pair<uint64_t, uint64_t>> LatencyHistogram::nonEmptyBuckets() const {
+    std::vector<std::pair<uint64_t, uint64_t>> buckets;
+    for (unsigned int i = 0; i < BUCKETS; i++) {
+        uint64_t count = _buckets[i].load(std::memory_order_relaxed);
+        if (count != 0) buckets.emplace_back(bucketUpperBound(i), count);
+    }
+    return buckets;
+}
+
+/**
+ * @brief Apaga todas as medições.
+ * Complexidade: O(B), sendo B o número de baldes.
+ */
+void LatencyHistogram::reset() {
+    for (auto &bucket: _buckets) bucket.store(0, std::memory_order_relaxed);
+    _count.store(0, std::memory_order_relaxed);
+    _sum.store(0, std::memory_order_relaxed);
+    _min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Calcula o balde de um valor: os valores abaixo de 32 têm um balde cada; acima disso, cada potência de 2 é
+ * dividida em 32 baldes iguais.
+ * Complexidade: O(1).
+ * @param value - Valor a registar.
+ * @return Índice do balde.
+ */
+unsigned int LatencyHistogram::bucketIndex(uint64_t value) {
+    const uint64_t subBuckets = 1ULL << SUB_BUCKET_BITS;
+    if (value < subBuckets) return static_cast<unsigned int>(value);
+    unsigned int exponent = 63 - __builtin_clzll(value);
+    unsigned int magnitude = exponent - SUB_BUCKET_BITS + 1;
+    if (magnitude > MAGNITUDES) return BUCKETS - 1;
+    unsigned int shift = exponent - SUB_BUCKET_BITS;
+    return (magnitude << SUB_BUCKET_BITS) + static_cast<unsigned int>((value >> shift) - subBuckets);
+}
+
+/**
+ * @brief Calcula o maior valor que cai num balde.
+ * Complexidade: O(1).
+ * @param index - Índice do balde.
+ * @return Limite superior do balde.
+ */
+uint64_t LatencyHistogram::bucketUpperBound(unsigned int index) {
+    const uint64_t subBuckets = 1ULL << SUB_BUCKET_BITS;
+    if (index < subBuckets) return index;
+    unsigned int magnitude = index >> SUB_BUCKET_BITS;
+    uint64_t subBucket = index & (subBuckets - 1);
+    unsigned int shift = magnitude - 1;
+    return ((subBuckets + subBucket) << shift) + (1ULL << shift) - 1;
+}
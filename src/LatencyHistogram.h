@@ -0,0 +1,62 @@
+#ifndef PROJECT_1_SCHEDULE_LATENCYHISTOGRAM_H
+#define PROJECT_1_SCHEDULE_LATENCYHISTOGRAM_H
+
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+/**
+ * @brief Histograma de latências com baldes log-lineares (estilo HDR): cada potência de 2 é dividida em 32 baldes,
+ * o que garante um erro relativo inferior a ~3% em qualquer percentil, entre 1 ns e várias horas, com memória fixa.
+ * Pode ser atualizado por várias threads em simultâneo.
+ */
+
+class LatencyHistogram {
+public:
+
+    LatencyHistogram();
+
+    void record(uint64_t nanoseconds);
+
+    [[nodiscard]] uint64_t getCount() const;
+
+    [[nodiscard]] uint64_t getSum() const;
+
+    [[nodiscard]] uint64_t getMin() const;
+
+    [[nodiscard]] uint64_t getMax() const;
+
+    [[nodiscard]] uint64_t percentile(double quantile) const;
+
+    [[nodiscard]] std::vector<std::pair<uint64_t, uint64_t>> nonEmptyBuckets() const;
+
+    void reset();
+
+private:
+    /** @brief Número de bits usados para dividir cada potência de 2 (32 baldes). */
+    static const unsigned int SUB_BUCKET_BITS = 5;
+    /** @brief Número de potências de 2 cobertas. */
+    static const unsigned int MAGNITUDES = 41;
+    /** @brief Número total de baldes. */
+    static const unsigned int BUCKETS = (MAGNITUDES + 1) << SUB_BUCKET_BITS;
+
+    /** @brief Número de medições em cada balde. */
+    std::atomic<uint64_t> _buckets[BUCKETS];
+    /** @brief Número total de medições. */
+    std::atomic<uint64_t> _count;
+    /** @brief Soma de todas as medições. */
+    std::atomic<uint64_t> _sum;
+    /** @brief Menor medição. */
+    std::atomic<uint64_t> _min;
+    /** @brief Maior medição. */
+    std::atomic<uint64_t> _max;
+
+    static unsigned int bucketIndex(uint64_t value);
+
+    static uint64_t bucketUpperBound(unsigned int index);
+};
+
+
+#endif //PROJECT_1_SCHEDULE_LATENCYHISTOGRAM_H
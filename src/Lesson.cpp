@@ -1,4 +1,5 @@
 #include "Lesson.h"
+#include "MemoryUsage.h"
 
 #include <utility>
 
@@ -46,20 +47,24 @@ const std::string &Lesson::getUcType() const {
 
 /**
  * @brief Permite obter o dia da semana da aula, em formato numérico.
+ * Os dias distinguem-se pelas duas primeiras letras, pelo que não é preciso procurar o nome num mapa (esta função é
+ * chamada em cada comparação ao ordenar aulas). Dias desconhecidos valem 0.
  * Complexidade: O(1).
  * @return Número correspondente ao dia da semana da aula.
  */
 int Lesson::getDayValue() const {
-    static std::map<std::string, int> dayToValue = {
-            {"Monday", 0},
-            {"Tuesday", 1},
-            {"Wednesday", 2},
-            {"Thursday", 3},
-            {"Friday", 4},
-            {"Saturday", 5},
-            {"Sunday", 6}
-    };
-    return dayToValue[_weekDay];
+    static const char *const days[] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"};
+    if (_weekDay.size() < 2) return 0;
+    int day;
+    switch (_weekDay[0]) {
+        case 'M': day = 0; break;
+        case 'W': day = 2; break;
+        case 'F': day = 4; break;
+        case 'T': day = _weekDay[1] == 'u' ? 1 : 3; break;
+        case 'S': day = _weekDay[1] == 'a' ? 5 : 6; break;
+        default: return 0;
+    }
+    return _weekDay == days[day] ? day : 0;
 }
 
 /**
@@ -112,3 +117,12 @@ bool Lesson::isOverlapping(const Lesson &other) const {
     return true;
 }
 
+
+/**
+ * @brief Estima a memória dinâmica ocupada pela aula (dia da semana, tipo e turma).
+ * Complexidade: O(1).
+ * @return Número de bytes.
+ */
+size_t Lesson::memoryUsage() const {
+    return MemoryUsage::string(_weekDay) + MemoryUsage::string(_ucType) + _ucSpecificClass.memoryUsage();
+}
@@ -32,6 +32,8 @@ public:
 
     bool operator<(const Lesson &rhs) const;
 
+    [[nodiscard]] size_t memoryUsage() const;
+
 private:
     /** @brief Dia da semana. */
     std::string _weekDay;
@@ -0,0 +1,290 @@
+#include "LessonTable.h"
+#include "MemoryUsage.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Construtor default da classe LessonTable.
+ * Complexidade: O(1).
+ */
+LessonTable::LessonTable() = default;
+
+/**
+ * @brief Constrói a tabela com as aulas de todas as turmas e calcula a máscara da semana de cada turma.
+ * Complexidade: O(L + C log C), sendo L o número de aulas e C o número de turmas.
+ * @param classes - Turmas.
+ */
+void LessonTable::build(const std::pmr::map<UCSpecificClass, Class> &classes) {
+    std::vector<std::pair<uint32_t, const Class *>> ordered;
+    ordered.reserve(classes.size());
+    size_t lessons = 0;
+    for (const auto &pair: classes) {
+        ordered.emplace_back(pair.first.getId(), &pair.second);
+        lessons += pair.second.getLessons().size();
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    _day.clear();
+    _start.clear();
+    _end.clear();
+    _type.clear();
+    _classId.clear();
+    _classIds.clear();
+    _firstLesson.clear();
+    _day.reserve(lessons);
+    _start.reserve(lessons);
+    _end.reserve(lessons);
+    _type.reserve(lessons);
+    _classId.reserve(lessons);
+    _classIds.reserve(ordered.size());
+    _firstLesson.reserve(ordered.size() + 1);
+    for (std::vector<uint64_t> &words: _busy) words.assign(ordered.size(), 0);
+    for (std::vector<uint64_t> &words: _occupied) words.assign(ordered.size(), 0);
+    _aligned = true;
+
+    for (size_t index = 0; index < ordered.size(); index++) {
+        _classIds.push_back(ordered[index].first);
+        _firstLesson.push_back(_day.size());
+        for (const Lesson &lesson: ordered[index].second->getLessons()) {
+            auto start = static_cast<uint16_t>(std::lround(lesson.getStartTime() * 60));
+            auto end = static_cast<uint16_t>(std::lround((lesson.getStartTime() + lesson.getDuration()) * 60));
+            Type type = typeOf(lesson.getUcType());
+            auto day = static_cast<uint8_t>(lesson.getDayValue());
+            if (day == 0 && lesson.getWeekDay() != "Monday") day = DAYS;
+            _day.push_back(day);
+            _start.push_back(start);
+            _end.push_back(end);
+            _type.push_back(type);
+            _classId.push_back(ordered[index].first);
+
+            if (day == DAYS || start % 30 != 0 || end % 30 != 0 || end > SLOTS_PER_DAY * 30) _aligned = false;
+            if (day == DAYS) continue;
+            for (unsigned int slot = start / 30; slot * 30 < end && slot < SLOTS_PER_DAY; slot++) {
+                unsigned int bit = day * SLOTS_PER_DAY + slot;
+                _occupied[bit / 64][index] |= uint64_t(1) << (bit % 64);
+                if (type != Theory) _busy[bit / 64][index] |= uint64_t(1) << (bit % 64);
+            }
+        }
+    }
+    _firstLesson.push_back(_day.size());
+}
+
+/**
+ * @brief Converte o tipo de uma aula (T, TP, PL) no tipo usado pela tabela.
+ * Complexidade: O(1).
+ * @param ucType - Tipo da aula.
+ * @return Tipo da aula (Other se não for nenhum dos conhecidos).
+ */
+LessonTable::Type LessonTable::typeOf(const std::string &ucType) {
+    return ucType == "T" ? Theory : ucType == "TP" ? TheoryPractice : ucType == "PL" ? Lab : Other;
+}
+
+/**
+ * @brief Permite obter o número de aulas da tabela.
+ * Complexidade: O(1).
+ * @return Número de aulas.
+ */
+size_t LessonTable::size() const {
+    return _day.size();
+}
+
+/**
+ * @brief Verifica se as máscaras são exatas, isto é, se todas as aulas têm dia conhecido e começam e acabam numa meia
+ * hora certa. Caso contrário, as sobreposições têm de ser confirmadas com conflicts().
+ * Complexidade: O(1).
+ * @return Verdadeiro se as máscaras forem exatas, falso caso contrário.
+ */
+bool LessonTable::isAligned() const {
+    return _aligned;
+}
+
+/**
+ * @brief Permite obter a posição de uma turma na tabela.
+ * Complexidade: O(log C).
+ * @param classId - Identificador compacto da turma.
+ * @return Posição da turma, ou -1 se não existir.
+ */
+int LessonTable::classIndex(uint32_t classId) const {
+    auto it = std::lower_bound(_classIds.begin(), _classIds.end(), classId);
+    if (it == _classIds.end() || *it != classId) return -1;
+    return static_cast<int>(it - _classIds.begin());
+}
+
+/**
+ * @brief Compara diretamente as aulas de duas turmas (usado quando as máscaras não são exatas).
+ * As aulas teóricas não contam para as sobreposições.
+ * Complexidade: O(A * B), sendo A e B o número de aulas de cada turma.
+ * @param classIndex - Posição da primeira turma.
+ * @param otherClassIndex - Posição da segunda turma.
+ * @return Verdadeiro se alguma aula de uma turma se sobrepõe a uma aula da outra, falso caso contrário.
+ */
+bool LessonTable::lessonsOverlap(int classIndex, int otherClassIndex) const {
+    for (uint32_t i = _firstLesson[classIndex]; i < _firstLesson[classIndex + 1]; i++) {
+        if (_type[i] == Theory) continue;
+        for (uint32_t j = _firstLesson[otherClassIndex]; j < _firstLesson[otherClassIndex + 1]; j++) {
+            if (_type[j] == Theory || _day[i] != _day[j]) continue;
+            if (_start[i] < _end[j] && _start[j] < _end[i]) return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Verifica se duas turmas têm aulas sobrepostas.
+ * Complexidade: O(log C).
+ * @param classId - Identificador compacto da primeira turma.
+ * @param otherClassId - Identificador compacto da segunda turma.
+ * @return Verdadeiro se houver sobreposição, falso caso contrário (ou se alguma das turmas não existir).
+ */
+bool LessonTable::conflicts(uint32_t classId, uint32_t otherClassId) const {
+    int a = classIndex(classId), b = classIndex(otherClassId);
+    if (a < 0 || b < 0) return false;
+    if (!_aligned) return lessonsOverlap(a, b);
+    return intersects(maskAt(_busy, a), maskAt(_busy, b));
+}
+
+/**
+ * @brief Calcula a união das máscaras de um conjunto de turmas.
+ * Complexidade: O(K log C), sendo K o número de turmas.
+ * @param masks - Máscaras de todas as turmas (_busy ou _occupied).
+ * @param classIds - Identificadores compactos das turmas.
+ * @return Máscara da semana.
+ */
+LessonTable::Mask LessonTable::unionMask(const std::array<std::vector<uint64_t>, WORDS> &masks,
+                                         const std::vector<uint32_t> &classIds) const {
+    Mask result{};
+    for (uint32_t classId: classIds) {
+        int index = classIndex(classId);
+        if (index < 0) continue;
+        merge(result, maskAt(masks, index));
+    }
+    return result;
+}
+
+/**
+ * @brief Junta as palavras da máscara de uma turma, que estão guardadas palavra a palavra.
+ * Complexidade: O(1).
+ * @param masks - Máscaras de todas as turmas (_busy ou _occupied).
+ * @param classIndex - Posição da turma.
+ * @return Máscara da semana da turma.
+ */
+LessonTable::Mask LessonTable::maskAt(const std::array<std::vector<uint64_t>, WORDS> &masks, int classIndex) {
+    Mask mask;
+    for (unsigned int w = 0; w < WORDS; w++) mask[w] = masks[w][classIndex];
+    return mask;
+}
+
+/**
+ * @brief Calcula a máscara da semana ocupada pelas aulas não teóricas de um conjunto de turmas.
+ * Complexidade: O(K log C), sendo K o número de turmas.
+ * @param classIds - Identificadores compactos das turmas.
+ * @return Máscara da semana.
+ */
+LessonTable::Mask LessonTable::busyMask(const std::vector<uint32_t> &classIds) const {
+    return unionMask(_busy, classIds);
+}
+
+/**
+ * @brief Calcula a máscara da semana ocupada por todas as aulas (incluindo as teóricas) de um conjunto de turmas.
+ * Complexidade: O(K log C), sendo K o número de turmas.
+ * @param classIds - Identificadores compactos das turmas.
+ * @return Máscara da semana.
+ */
+LessonTable::Mask LessonTable::occupiedMask(const std::vector<uint32_t> &classIds) const {
+    return unionMask(_occupied, classIds);
+}
+
+/**
+ * @brief Procura, numa máscara da semana, os intervalos livres com pelo menos 'minSlots' meias horas seguidas, entre
+ * as meias horas 'firstSlot' e 'lastSlot' de cada um dos primeiros 'days' dias. Cada dia é extraído para uma palavra e
+ * os intervalos são percorridos com contagem de zeros, sem testar meia hora a meia hora. Como as aulas que não
+ * começam ou acabam numa meia hora certa ocupam a meia hora inteira na máscara, os intervalos nunca se sobrepõem a
+ * uma aula.
+ * Complexidade: O(D + W), sendo D o número de dias e W o número de intervalos livres.
+ * @param occupied - Meias horas ocupadas.
+ * @param minSlots - Duração mínima, em meias horas.
+ * @param firstSlot - Primeira meia hora de cada dia a considerar.
+ * @param lastSlot - Meia hora de cada dia onde a procura termina (exclusive).
+ * @param days - Número de dias a considerar, a partir de segunda-feira.
+ * @return Intervalos livres, por dia e hora de início.
+ */
+std::vector<FreeWindow> LessonTable::freeWindows(const Mask &occupied, unsigned int minSlots, unsigned int firstSlot,
+                                                 unsigned int lastSlot, unsigned int days) {
+    std::vector<FreeWindow> windows;
+    lastSlot = std::min(lastSlot, SLOTS_PER_DAY);
+    if (firstSlot >= lastSlot) return windows;
+    minSlots = std::max(minSlots, 1u);
+    const uint64_t range = ((uint64_t(1) << (lastSlot - firstSlot)) - 1) << firstSlot;
+    for (unsigned int day = 0; day < std::min(days, DAYS); day++) {
+        unsigned int offset = day * SLOTS_PER_DAY, word = offset / 64, shift = offset % 64;
+        uint64_t slots = occupied[word] >> shift;
+        if (shift + SLOTS_PER_DAY > 64) slots |= occupied[word + 1] << (64 - shift);
+        uint64_t free = ~slots & range;
+        while (free != 0) {
+            unsigned int start = __builtin_ctzll(free);
+            uint64_t rest = ~(free >> start);
+            unsigned int length = rest == 0 ? 64 - start : __builtin_ctzll(rest);
+            if (length >= minSlots) {
+                windows.push_back({static_cast<uint8_t>(day), static_cast<uint16_t>(start * 30),
+                                   static_cast<uint16_t>((start + length) * 30)});
+            }
+            free &= start + length >= 64 ? 0 : ~uint64_t(0) << (start + length);
+        }
+    }
+    return windows;
+}
+
+/**
+ * @brief Permite obter as turmas de uma UC sem sobreposições com um conjunto de turmas (por exemplo, o horário atual
+ * de um aluno). As máscaras de todas as turmas da UC são testadas de uma só vez, palavra a palavra.
+ * Complexidade: O(K log C + U), sendo K o número de turmas ocupadas e U o número de turmas da UC.
+ * @param ucId - Identificador da UC.
+ * @param busyClassIds - Identificadores compactos das turmas que ocupam o horário.
+ * @return Identificadores compactos das turmas compatíveis, por ordem crescente.
+ */
+std::vector<uint32_t> LessonTable::compatibleClasses(uint16_t ucId, const std::vector<uint32_t> &busyClassIds) const {
+    auto first = std::lower_bound(_classIds.begin(), _classIds.end(), uint32_t(ucId) << 16);
+    auto last = std::lower_bound(first, _classIds.end(), (uint32_t(ucId) + 1) << 16);
+    size_t begin = first - _classIds.begin(), count = last - first;
+
+    std::vector<uint64_t> overlap(count, 0);
+    if (_aligned) {
+        Mask busy = busyMask(busyClassIds);
+        for (unsigned int w = 0; w < WORDS; w++) {
+            const uint64_t *words = _busy[w].data() + begin;
+            uint64_t mask = busy[w];
+            for (size_t i = 0; i < count; i++) overlap[i] |= words[i] & mask;
+        }
+    } else {
+        for (uint32_t busyClassId: busyClassIds) {
+            int busyIndex = classIndex(busyClassId);
+            if (busyIndex < 0) continue;
+            for (size_t i = 0; i < count; i++) {
+                if (lessonsOverlap(static_cast<int>(begin + i), busyIndex)) overlap[i] = 1;
+            }
+        }
+    }
+
+    std::vector<uint32_t> compatible;
+    for (size_t i = 0; i < count; i++) {
+        if (overlap[i] == 0) compatible.push_back(_classIds[begin + i]);
+    }
+    return compatible;
+}
+
+/**
+ * @brief Estima a memória dinâmica ocupada pela tabela.
+ * Complexidade: O(1).
+ * @return Número de bytes.
+ */
+size_t LessonTable::memoryUsage() const {
+    size_t bytes = MemoryUsage::vectorBuffer(_day) + MemoryUsage::vectorBuffer(_start) +
+                   MemoryUsage::vectorBuffer(_end) + MemoryUsage::vectorBuffer(_type) +
+                   MemoryUsage::vectorBuffer(_classId) + MemoryUsage::vectorBuffer(_classIds) +
+                   MemoryUsage::vectorBuffer(_firstLesson);
+    for (const std::vector<uint64_t> &words: _busy) bytes += MemoryUsage::vectorBuffer(words);
+    for (const std::vector<uint64_t> &words: _occupied) bytes += MemoryUsage::vectorBuffer(words);
+    return bytes;
+}
@@ -0,0 +1,156 @@
+#ifndef PROJECT_1_SCHEDULE_LESSONTABLE_H
+#define PROJECT_1_SCHEDULE_LESSONTABLE_H
+
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "Class.h"
+
+/**
+ * @brief Intervalo livre de um dia da semana.
+ */
+
+struct FreeWindow {
+    /** @brief Dia da semana (0 = segunda-feira). */
+    uint8_t day;
+    /** @brief Início do intervalo, em minutos desde as 00:00. */
+    uint16_t start;
+    /** @brief Fim do intervalo, em minutos desde as 00:00. */
+    uint16_t end;
+};
+
+/**
+ * @brief Tabela de todas as aulas em estrutura de vetores (dia, início, fim, tipo e turma, cada um no seu vetor),
+ * ordenada pelo identificador compacto da turma e, portanto, agrupada por UC e por turma.
+ * Para cada turma guarda também a máscara da semana ocupada pelas suas aulas não teóricas (as únicas que contam para
+ * as sobreposições) e a máscara de todas as suas aulas: 7 dias de 48 meias horas, em 6 palavras de 64 bits. As
+ * máscaras estão guardadas palavra a palavra (a palavra w de todas as turmas seguidas), para que testar todas as turmas
+ * de uma UC contra um horário seja um ciclo simples e sem ramos sobre memória contígua, que testa 64 meias horas por
+ * operação. O compilador só o vetoriza com -O3; na compilação por omissão (sem otimização) e com -O2 é um ciclo
+ * escalar.
+ * Se alguma aula não começar ou acabar numa meia hora certa, as máscaras não são exatas e as consultas comparam os
+ * intervalos das aulas.
+ */
+
+class LessonTable {
+public:
+    /** @brief Número de dias da semana. */
+    static constexpr unsigned int DAYS = 7;
+    /** @brief Número de meias horas de cada dia. */
+    static constexpr unsigned int SLOTS_PER_DAY = 48;
+    /** @brief Número de palavras de 64 bits de uma máscara da semana. */
+    static constexpr unsigned int WORDS = (DAYS * SLOTS_PER_DAY + 63) / 64;
+
+    /** @brief Máscara das meias horas ocupadas numa semana. */
+    using Mask = std::array<uint64_t, WORDS>;
+
+    /**
+     * @brief Verifica se duas máscaras da semana têm alguma meia hora em comum. Definida aqui para ser expandida nos
+     * ciclos de procura do TimetableGenerator e do CohortPlacer.
+     * Complexidade: O(1).
+     * @param a - Primeira máscara.
+     * @param b - Segunda máscara.
+     * @return Verdadeiro se as máscaras se intersetarem, falso caso contrário.
+     */
+    static bool intersects(const Mask &a, const Mask &b) {
+        uint64_t common = 0;
+        for (unsigned int w = 0; w < WORDS; w++) common |= a[w] & b[w];
+        return common != 0;
+    }
+
+    /**
+     * @brief Acrescenta as meias horas de uma máscara a outra.
+     * Complexidade: O(1).
+     * @param into - Máscara que recebe as meias horas.
+     * @param from - Máscara acrescentada.
+     */
+    static void merge(Mask &into, const Mask &from) {
+        for (unsigned int w = 0; w < WORDS; w++) into[w] |= from[w];
+    }
+
+    /** @brief Tipos de aula. Só as teóricas (T) podem sobrepor-se a outras aulas. */
+    enum Type : uint8_t { Theory, TheoryPractice, Lab, Other };
+    /** @brief Número de tipos de aula. */
+    static constexpr unsigned int TYPES = 4;
+
+    LessonTable();
+
+    void build(const std::pmr::map<UCSpecificClass, Class> &classes);
+
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] bool isAligned() const;
+
+    [[nodiscard]] bool conflicts(uint32_t classId, uint32_t otherClassId) const;
+
+    [[nodiscard]] std::vector<uint32_t> compatibleClasses(uint16_t ucId, const std::vector<uint32_t> &busyClassIds) const;
+
+    [[nodiscard]] Mask busyMask(const std::vector<uint32_t> &classIds) const;
+
+    [[nodiscard]] Mask occupiedMask(const std::vector<uint32_t> &classIds) const;
+
+    static std::vector<FreeWindow> freeWindows(const Mask &occupied, unsigned int minSlots, unsigned int firstSlot,
+                                               unsigned int lastSlot, unsigned int days);
+
+    [[nodiscard]] size_t memoryUsage() const;
+
+    static Type typeOf(const std::string &ucType);
+
+    /**
+     * @brief Percorre as aulas de uma turma, indicando para cada uma as meias horas que ocupa (uma aula que não começa
+     * ou acaba numa meia hora certa ocupa a meia hora inteira). As aulas de dia desconhecido são ignoradas.
+     * Complexidade: O(log C + A), sendo A o número de aulas da turma.
+     * @param classId - Identificador compacto da turma.
+     * @param visit - Função chamada com o dia, a primeira meia hora, a meia hora seguinte à última e o tipo da aula.
+     */
+    template<typename Visit>
+    void forEachLesson(uint32_t classId, Visit visit) const {
+        int index = classIndex(classId);
+        if (index < 0) return;
+        for (uint32_t i = _firstLesson[index]; i < _firstLesson[index + 1]; i++) {
+            if (_day[i] == DAYS) continue;
+            unsigned int first = _start[i] / 30, last = std::min<unsigned int>((_end[i] + 29) / 30, SLOTS_PER_DAY);
+            if (first < last) visit(_day[i], first, last, static_cast<Type>(_type[i]));
+        }
+    }
+
+private:
+    /** @brief Dia da semana de cada aula (0 = segunda-feira, DAYS se o dia for desconhecido). */
+    std::vector<uint8_t> _day;
+    /** @brief Início de cada aula, em minutos desde as 00:00. */
+    std::vector<uint16_t> _start;
+    /** @brief Fim de cada aula, em minutos desde as 00:00. */
+    std::vector<uint16_t> _end;
+    /** @brief Tipo de cada aula. */
+    std::vector<uint8_t> _type;
+    /** @brief Identificador compacto da turma de cada aula. */
+    std::vector<uint32_t> _classId;
+
+    /** @brief Identificadores das turmas, por ordem crescente. */
+    std::vector<uint32_t> _classIds;
+    /** @brief Primeira aula de cada turma (com uma posição extra no fim). */
+    std::vector<uint32_t> _firstLesson;
+    /** @brief Palavra w da máscara de cada turma, em _busy[w][turma]. */
+    std::array<std::vector<uint64_t>, WORDS> _busy;
+    /** @brief Palavra w da máscara de todas as aulas (incluindo as teóricas) de cada turma, em _occupied[w][turma]. */
+    std::array<std::vector<uint64_t>, WORDS> _occupied;
+    /** @brief Indica se todas as aulas começam e acabam numa meia hora certa (máscaras exatas). */
+    bool _aligned = true;
+
+    [[nodiscard]] int classIndex(uint32_t classId) const;
+
+    [[nodiscard]] bool lessonsOverlap(int classIndex, int otherClassIndex) const;
+
+    [[nodiscard]] Mask unionMask(const std::array<std::vector<uint64_t>, WORDS> &masks,
+                                 const std::vector<uint32_t> &classIds) const;
+
+    static Mask maskAt(const std::array<std::vector<uint64_t>, WORDS> &masks, int classIndex);
+};
+
+
+#endif //PROJECT_1_SCHEDULE_LESSONTABLE_H
@@ -0,0 +1,36 @@
+#include "MemoryUsage.h"
+
+/**
+ * @brief Estima o tamanho real de um bloco pedido ao malloc (8 bytes de cabeçalho, alinhamento a 16 bytes e
+ * tamanho mínimo de 32 bytes).
+ * Complexidade: O(1).
+ * @param bytes - Número de bytes pedidos.
+ * @return Número de bytes efetivamente ocupados.
+ */
+size_t MemoryUsage::heapBlock(size_t bytes) {
+    size_t block = (bytes + 8 + 15) & ~static_cast<size_t>(15);
+    return block < 32 ? 32 : block;
+}
+
+/**
+ * @brief Estima a memória dinâmica de uma string. Strings curtas ficam guardadas dentro do próprio objeto
+ * (small string optimization) e não ocupam memória dinâmica.
+ * Complexidade: O(1).
+ * @param text - String.
+ * @return Número de bytes.
+ */
+size_t MemoryUsage::string(const std::string &text) {
+    const char *object = reinterpret_cast<const char *>(&text);
+    if (text.data() >= object && text.data() < object + sizeof(text)) return 0;
+    return heapBlock(text.capacity() + 1);
+}
+
+/**
+ * @brief Estima a memória de um nó de std::map / std::set.
+ * Complexidade: O(1).
+ * @param valueSize - Tamanho do valor guardado no nó.
+ * @return Número de bytes.
+ */
+size_t MemoryUsage::treeNode(size_t valueSize) {
+    return heapBlock(TREE_NODE_HEADER + valueSize);
+}
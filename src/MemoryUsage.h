@@ -0,0 +1,76 @@
+#ifndef PROJECT_1_SCHEDULE_MEMORYUSAGE_H
+#define PROJECT_1_SCHEDULE_MEMORYUSAGE_H
+
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Funções auxiliares que estimam a memória dinâmica ocupada pelas estruturas da biblioteca standard
+ * (libstdc++ sobre o malloc da glibc), usadas para percorrer os dados e contabilizar o seu tamanho.
+ */
+
+class MemoryUsage {
+public:
+    /** @brief Tamanho do cabeçalho de um nó de std::map / std::set (cor, pai e dois filhos). */
+    static const size_t TREE_NODE_HEADER = 32;
+    /** @brief Tamanho de cada bloco de um std::deque. */
+    static const size_t DEQUE_BLOCK = 512;
+
+    static size_t heapBlock(size_t bytes);
+
+    static size_t string(const std::string &text);
+
+    static size_t treeNode(size_t valueSize);
+
+    /**
+     * @brief Estima a memória do buffer de um vetor (sem contar a memória dos elementos). Os vetores alocados numa
+     * arena não têm o cabeçalho nem o arredondamento do malloc.
+     * Complexidade: O(1).
+     * @param vector - Vetor.
+     * @return Número de bytes.
+     */
+    template<typename T, typename Allocator>
+    static size_t vectorBuffer(const std::vector<T, Allocator> &vector) {
+        if (vector.capacity() == 0) return 0;
+        size_t bytes = vector.capacity() * sizeof(T);
+        if constexpr (std::is_same_v<Allocator, std::pmr::polymorphic_allocator<T>>) {
+            if (vector.get_allocator().resource() != std::pmr::new_delete_resource()) return bytes;
+        }
+        return heapBlock(bytes);
+    }
+
+    /**
+     * @brief Estima a memória dos blocos e do mapa de um std::deque com 'size' elementos (sem contar a memória dos
+     * elementos).
+     * Complexidade: O(1).
+     * @param size - Número de elementos.
+     * @return Número de bytes.
+     */
+    template<typename T>
+    static size_t dequeBuffers(size_t size) {
+        size_t perBlock = sizeof(T) < DEQUE_BLOCK ? DEQUE_BLOCK / sizeof(T) : 1;
+        size_t blocks = size / perBlock + 1;
+        return blocks * heapBlock(perBlock * sizeof(T)) + heapBlock((blocks + 2 > 8 ? blocks + 2 : 8) * sizeof(void *));
+    }
+
+    /**
+     * @brief Permite percorrer o contentor interno de um std::queue ou std::stack sem o copiar.
+     * Complexidade: O(1).
+     * @param adapter - Fila ou pilha.
+     * @return Contentor interno.
+     */
+    template<typename Adapter>
+    static const typename Adapter::container_type &container(const Adapter &adapter) {
+        struct Access : Adapter {
+            static const typename Adapter::container_type &get(const Adapter &a) { return a.*(&Access::c); }
+        };
+        return Access::get(adapter);
+    }
+};
+
+
+#endif //PROJECT_1_SCHEDULE_MEMORYUSAGE_H
@@ -0,0 +1,72 @@
+#include "OccupancyHeatmap.h"
+
+/**
+ * @brief Põe a zero o mapa de todas as turmas.
+ * Complexidade: O(S), sendo S o número de meias horas da semana.
+ */
+void OccupancyHeatmap::clear() {
+    for (Counts &counts: _byType) counts.fill(0);
+}
+
+/**
+ * @brief Soma um número de alunos (negativo, se a turma perdeu alunos) às meias horas das aulas de uma turma.
+ * Complexidade: O(log C + A), sendo C o número de turmas e A o número de meias horas das aulas da turma.
+ * @param table - Tabela das aulas.
+ * @param classId - Identificador compacto da turma.
+ * @param students - Variação do número de alunos da turma.
+ */
+void OccupancyHeatmap::add(const LessonTable &table, uint32_t classId, int64_t students) {
+    if (students == 0) return;
+    table.forEachLesson(classId, [&](unsigned int day, unsigned int first, unsigned int last, LessonTable::Type type) {
+        int64_t *counts = _byType[type].data() + day * LessonTable::SLOTS_PER_DAY;
+        for (unsigned int slot = first; slot < last; slot++) counts[slot] += students;
+    });
+}
+
+/**
+ * @brief Permite obter o mapa de todas as turmas, só com os tipos de aula indicados.
+ * Complexidade: O(T * S), sendo T o número de tipos de aula e S o número de meias horas da semana.
+ * @param typeMask - Tipos de aula a contar (bit 1 << LessonTable::Type).
+ * @return Número de alunos em cada meia hora.
+ */
+OccupancyHeatmap::Counts OccupancyHeatmap::counts(unsigned int typeMask) const {
+    Counts total{};
+    for (unsigned int type = 0; type < LessonTable::TYPES; type++) {
+        if ((typeMask >> type & 1) == 0) continue;
+        for (unsigned int slot = 0; slot < SLOTS; slot++) total[slot] += _byType[type][slot];
+    }
+    return total;
+}
+
+/**
+ * @brief Calcula o mapa de um conjunto de turmas por varrimento: cada aula soma o número de alunos da turma na meia
+ * hora onde começa e subtrai-o na meia hora onde acaba, e as somas acumuladas de cada dia dão a ocupação.
+ * Complexidade: O(K log C + L + S), sendo K o número de turmas, L o número de aulas dessas turmas e S o número de
+ * meias horas da semana.
+ * @param table - Tabela das aulas.
+ * @param classes - Identificadores compactos das turmas e respetivo número de alunos.
+ * @param typeMask - Tipos de aula a contar (bit 1 << LessonTable::Type).
+ * @return Número de alunos em cada meia hora.
+ */
+OccupancyHeatmap::Counts OccupancyHeatmap::sweep(const LessonTable &table,
+                                                 const std::vector<std::pair<uint32_t, int64_t>> &classes,
+                                                 unsigned int typeMask) {
+    std::array<int64_t, LessonTable::DAYS * (LessonTable::SLOTS_PER_DAY + 1)> difference{};
+    for (const auto &entry: classes) {
+        table.forEachLesson(entry.first, [&](unsigned int day, unsigned int first, unsigned int last,
+                                             LessonTable::Type type) {
+            if ((typeMask >> type & 1) == 0) return;
+            difference[day * (LessonTable::SLOTS_PER_DAY + 1) + first] += entry.second;
+            difference[day * (LessonTable::SLOTS_PER_DAY + 1) + last] -= entry.second;
+        });
+    }
+    Counts counts{};
+    for (unsigned int day = 0; day < LessonTable::DAYS; day++) {
+        int64_t running = 0;
+        for (unsigned int slot = 0; slot < LessonTable::SLOTS_PER_DAY; slot++) {
+            running += difference[day * (LessonTable::SLOTS_PER_DAY + 1) + slot];
+            counts[day * LessonTable::SLOTS_PER_DAY + slot] = running;
+        }
+    }
+    return counts;
+}
@@ -0,0 +1,44 @@
+#ifndef PROJECT_1_SCHEDULE_OCCUPANCYHEATMAP_H
+#define PROJECT_1_SCHEDULE_OCCUPANCYHEATMAP_H
+
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "LessonTable.h"
+
+/**
+ * @brief Número de alunos em aula em cada meia hora da semana (mapa de ocupação), para planear salas e espaços.
+ * O mapa de todas as turmas é guardado por tipo de aula e mantido incrementalmente: quando uma turma ganha ou perde
+ * alunos, só as meias horas das suas aulas mudam. Os mapas de um subconjunto das turmas (de um ano ou de uma UC) são
+ * calculados com um varrimento: cada aula soma o número de alunos da turma no início e subtrai-o no fim, num vetor de
+ * diferenças por dia, e as somas acumuladas dão a ocupação de cada meia hora.
+ */
+
+class OccupancyHeatmap {
+public:
+    /** @brief Número de meias horas da semana. */
+    static constexpr unsigned int SLOTS = LessonTable::DAYS * LessonTable::SLOTS_PER_DAY;
+    /** @brief Máscara com todos os tipos de aula. */
+    static constexpr unsigned int ALL_TYPES = (1u << LessonTable::TYPES) - 1;
+
+    /** @brief Número de alunos em cada meia hora (índice dia * SLOTS_PER_DAY + meia hora). */
+    using Counts = std::array<int64_t, SLOTS>;
+
+    void clear();
+
+    void add(const LessonTable &table, uint32_t classId, int64_t students);
+
+    [[nodiscard]] Counts counts(unsigned int typeMask = ALL_TYPES) const;
+
+    static Counts sweep(const LessonTable &table, const std::vector<std::pair<uint32_t, int64_t>> &classes,
+                        unsigned int typeMask = ALL_TYPES);
+
+private:
+    /** @brief Mapa de todas as turmas, separado por tipo de aula. */
+    std::array<Counts, LessonTable::TYPES> _byType{};
+};
+
+
+#endif //PROJECT_1_SCHEDULE_OCCUPANCYHEATMAP_H
@@ -0,0 +1,135 @@
+#ifndef PROJECT_1_SCHEDULE_OCCUPANCYINDEX_H
+#define PROJECT_1_SCHEDULE_OCCUPANCYINDEX_H
+
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Índice do número de alunos de cada chave (turma ou unidade curricular), mantido incrementalmente.
+ * As chaves estão num conjunto ordenado por (número de alunos, chave), pelo que obter as K mais cheias ou mais vazias,
+ * ou as que têm pelo menos um dado número de alunos, custa O(log N + K). Em caso de empate as chaves saem por ordem
+ * crescente. Cada alteração do número de alunos custa O(log N).
+ */
+
+template<typename Key>
+class OccupancyIndex {
+public:
+    /** @brief Chave e respetivo número de alunos. */
+    using Entry = std::pair<Key, unsigned int>;
+
+    /**
+     * @brief Remove todas as chaves do índice.
+     * Complexidade: O(N).
+     */
+    void clear() {
+        _counts.clear();
+        _byCount.clear();
+    }
+
+    /**
+     * @brief Define o número de alunos de uma chave, acrescentando-a ao índice se ainda não existir.
+     * Complexidade: O(log N).
+     * @param key - Chave.
+     * @param count - Número de alunos.
+     */
+    void set(const Key &key, unsigned int count) {
+        auto it = _counts.find(key);
+        if (it == _counts.end()) {
+            it = _counts.emplace(key, count).first;
+        } else {
+            _byCount.erase({it->second, key});
+            it->second = count;
+        }
+        _byCount.emplace(count, key);
+    }
+
+    /**
+     * @brief Soma 'delta' ao número de alunos de uma chave.
+     * Complexidade: O(log N).
+     * @param key - Chave.
+     * @param delta - Variação do número de alunos.
+     */
+    void add(const Key &key, int delta) {
+        set(key, count(key) + delta);
+    }
+
+    /**
+     * @brief Permite obter o número de alunos de uma chave.
+     * Complexidade: O(log N).
+     * @param key - Chave.
+     * @return Número de alunos (0 se a chave não estiver no índice).
+     */
+    [[nodiscard]] unsigned int count(const Key &key) const {
+        auto it = _counts.find(key);
+        return it == _counts.end() ? 0 : it->second;
+    }
+
+    /**
+     * @brief Permite obter o número de chaves do índice.
+     * Complexidade: O(1).
+     * @return Número de chaves.
+     */
+    [[nodiscard]] size_t size() const {
+        return _counts.size();
+    }
+
+    /**
+     * @brief Permite obter as K chaves com mais alunos, por ordem decrescente do número de alunos.
+     * Complexidade: O(D log N + K), sendo D o número de valores distintos percorridos.
+     * @param k - Número de chaves.
+     * @return Chaves e número de alunos.
+     */
+    [[nodiscard]] std::vector<Entry> mostFilled(size_t k) const {
+        std::vector<Entry> result;
+        auto groupEnd = _byCount.end();
+        while (result.size() < k && groupEnd != _byCount.begin()) {
+            // Percorre cada grupo de chaves com o mesmo número de alunos por ordem crescente da chave.
+            auto groupBegin = _byCount.lower_bound({std::prev(groupEnd)->first, Key()});
+            for (auto it = groupBegin; it != groupEnd && result.size() < k; it++) {
+                result.emplace_back(it->second, it->first);
+            }
+            groupEnd = groupBegin;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Permite obter as K chaves com menos alunos, por ordem crescente do número de alunos.
+     * Complexidade: O(K).
+     * @param k - Número de chaves.
+     * @return Chaves e número de alunos.
+     */
+    [[nodiscard]] std::vector<Entry> leastFilled(size_t k) const {
+        std::vector<Entry> result;
+        for (auto it = _byCount.begin(); it != _byCount.end() && result.size() < k; it++) {
+            result.emplace_back(it->second, it->first);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Permite obter as chaves com pelo menos 'minimum' alunos, por ordem crescente do número de alunos.
+     * Complexidade: O(log N + K), sendo K o número de chaves devolvidas.
+     * @param minimum - Número mínimo de alunos.
+     * @return Chaves e número de alunos.
+     */
+    [[nodiscard]] std::vector<Entry> atLeast(unsigned int minimum) const {
+        std::vector<Entry> result;
+        for (auto it = _byCount.lower_bound({minimum, Key()}); it != _byCount.end(); it++) {
+            result.emplace_back(it->second, it->first);
+        }
+        return result;
+    }
+
+private:
+    /** @brief Número de alunos de cada chave. */
+    std::map<Key, unsigned int> _counts;
+    /** @brief Pares (número de alunos, chave), por ordem crescente. */
+    std::set<std::pair<unsigned int, Key>> _byCount;
+};
+
+
+#endif //PROJECT_1_SCHEDULE_OCCUPANCYINDEX_H
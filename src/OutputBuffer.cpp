@@ -0,0 +1,110 @@
+#include "OutputBuffer.h"
+
+/**
+ * @brief Construtor da classe OutputBuffer.
+ * Se for indicado um paginador e for possível iniciá-lo, o texto é-lhe enviado; caso contrário é escrito em 'out'.
+ * Complexidade: O(1).
+ * @param out - Destino do texto.
+ * @param pager - Comando do paginador (vazio para escrever diretamente em 'out').
+ */
+OutputBuffer::OutputBuffer(std::ostream &out, const std::string &pager) : _out(out) {
+    _buffer.swap(spareBuffer());
+    _buffer.reserve(CAPACITY);
+    if (!pager.empty()) {
+        _out.flush();
+        _pager = popen(pager.c_str(), "w");
+    }
+}
+
+/**
+ * @brief Destrutor da classe OutputBuffer. Escreve o texto que falta e fecha o paginador.
+ * O buffer fica guardado para ser reutilizado pelo próximo OutputBuffer.
+ * Complexidade: O(N), sendo N o tamanho do texto por escrever.
+ */
+OutputBuffer::~OutputBuffer() {
+    close();
+    spareBuffer().swap(_buffer);
+}
+
+/**
+ * @brief Acrescenta texto ao buffer, escrevendo-o se ficar cheio.
+ * Complexidade: O(N), sendo N o tamanho do texto.
+ * @param text - Texto.
+ * @return Este buffer.
+ */
+OutputBuffer &OutputBuffer::operator<<(std::string_view text) {
+    _buffer.append(text);
+    if (_buffer.size() >= CAPACITY) flush();
+    return *this;
+}
+
+/**
+ * @brief Acrescenta texto ao buffer.
+ * Complexidade: O(N), sendo N o tamanho do texto.
+ * @param text - Texto.
+ * @return Este buffer.
+ */
+OutputBuffer &OutputBuffer::operator<<(const char *text) {
+    return *this << std::string_view(text);
+}
+
+/**
+ * @brief Acrescenta texto ao buffer.
+ * Complexidade: O(N), sendo N o tamanho do texto.
+ * @param text - Texto.
+ * @return Este buffer.
+ */
+OutputBuffer &OutputBuffer::operator<<(const std::string &text) {
+    return *this << std::string_view(text);
+}
+
+/**
+ * @brief Acrescenta um carácter ao buffer.
+ * Complexidade: O(1).
+ * @param c - Carácter.
+ * @return Este buffer.
+ */
+OutputBuffer &OutputBuffer::operator<<(char c) {
+    _buffer.push_back(c);
+    if (_buffer.size() >= CAPACITY) flush();
+    return *this;
+}
+
+/**
+ * @brief Escreve todo o texto acumulado no destino.
+ * Complexidade: O(N), sendo N o tamanho do texto.
+ */
+void OutputBuffer::flush() {
+    if (_pager != nullptr) {
+        fwrite(_buffer.data(), 1, _buffer.size(), _pager);
+        fflush(_pager);
+    } else {
+        _out.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _out.flush();
+    }
+    _buffer.clear();
+}
+
+/**
+ * @brief Escreve o texto que falta e, se houver paginador, espera que o utilizador o feche. Depois disso o texto
+ * passa a ser escrito diretamente no destino original.
+ * Complexidade: O(N), sendo N o tamanho do texto por escrever.
+ */
+void OutputBuffer::close() {
+    flush();
+    if (_pager != nullptr) {
+        pclose(_pager);
+        _pager = nullptr;
+    }
+}
+
+/**
+ * @brief Permite obter o buffer guardado entre utilizações (um por thread), para não alocar um buffer novo em cada
+ * listagem.
+ * Complexidade: O(1).
+ * @return Buffer guardado.
+ */
+std::string &OutputBuffer::spareBuffer() {
+    static thread_local std::string spare;
+    return spare;
+}
@@ -0,0 +1,69 @@
+#ifndef PROJECT_1_SCHEDULE_OUTPUTBUFFER_H
+#define PROJECT_1_SCHEDULE_OUTPUTBUFFER_H
+
+
+#include <charconv>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief Buffer de escrita para listagens longas: o texto é formatado num buffer reutilizado e escrito em blocos de
+ * CAPACITY bytes, em vez de uma escrita (e um flush, com std::endl) por linha.
+ * O destino pode ser um std::ostream (terminal ou ficheiro) ou um paginador (por exemplo "less"), que recebe o texto
+ * por um pipe. O buffer é escrito quando enche e quando o objeto é destruído.
+ */
+
+class OutputBuffer {
+public:
+    /** @brief Número de bytes acumulados antes de cada escrita. */
+    static const size_t CAPACITY = 1 << 16;
+
+    explicit OutputBuffer(std::ostream &out, const std::string &pager = "");
+
+    OutputBuffer(const OutputBuffer &) = delete;
+
+    OutputBuffer &operator=(const OutputBuffer &) = delete;
+
+    ~OutputBuffer();
+
+    OutputBuffer &operator<<(std::string_view text);
+
+    OutputBuffer &operator<<(const char *text);
+
+    OutputBuffer &operator<<(const std::string &text);
+
+    OutputBuffer &operator<<(char c);
+
+    /**
+     * @brief Escreve um número inteiro, sem passar por um std::ostream.
+     * Complexidade: O(1).
+     * @param value - Número.
+     * @return Este buffer.
+     */
+    template<typename Integer, typename = std::enable_if_t<std::is_integral_v<Integer>>>
+    OutputBuffer &operator<<(Integer value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        return *this << std::string_view(digits, result.ptr - digits);
+    }
+
+    void flush();
+
+    void close();
+
+private:
+    /** @brief Texto ainda não escrito. */
+    std::string _buffer;
+    /** @brief Destino do texto quando não há paginador. */
+    std::ostream &_out;
+    /** @brief Pipe para o paginador, ou nullptr. */
+    FILE *_pager = nullptr;
+
+    static std::string &spareBuffer();
+};
+
+
+#endif //PROJECT_1_SCHEDULE_OUTPUTBUFFER_H
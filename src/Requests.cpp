@@ -1,4 +1,5 @@
 #include "Requests.h"
+#include "MemoryUsage.h"
 
 /**
  * @brief Construtor da classe Requests.
@@ -38,4 +39,13 @@ UCSpecificClass Requests::getDesiredClass() const {
  */
 std::string Requests::gettypeRequest() {
     return _typeRequest;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Estima a memória dinâmica ocupada pelo pedido (cópia do aluno, turma desejada e tipo).
+ * Complexidade: O(N), sendo N o número de turmas do aluno.
+ * @return Número de bytes.
+ */
+size_t Requests::memoryUsage() const {
+    return _student.memoryUsage() + _desiredClass.memoryUsage() + MemoryUsage::string(_typeRequest);
+}
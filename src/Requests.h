@@ -3,6 +3,7 @@
 
 #include "Student.h"
 #include <iostream>
+#include <vector>
 
 /**
  * @brief Classe que permite armazenar as informações sobre um pedido.
@@ -17,6 +18,9 @@ public:
     [[nodiscard]] UCSpecificClass getDesiredClass() const;
 
     std::string gettypeRequest();
+
+    [[nodiscard]] size_t memoryUsage() const;
+
 private:
     /** @brief Aluno associado ao pedido. */
     Student _student;
@@ -26,5 +30,18 @@ private:
     std::string _typeRequest;
 };
 
+/**
+ * @brief Pedido recusado, com a razão da recusa e as turmas da mesma UC que o aluno podia pedir em alternativa.
+ */
+
+struct RejectedRequest {
+    /** @brief Pedido recusado. */
+    Requests request;
+    /** @brief Razão da recusa. */
+    std::string reason;
+    /** @brief Identificadores compactos das turmas alternativas, da mais recomendada para a menos recomendada. */
+    std::vector<uint32_t> alternatives;
+};
+
 
 #endif //PROJECT_1_SCHEDULE_REQUESTS_H
@@ -0,0 +1,139 @@
+#include "Roster.h"
+#include "MemoryUsage.h"
+
+#include <algorithm>
+#include <iterator>
+
+/**
+ * @brief Construtor default da classe Roster.
+ * Complexidade: O(1).
+ */
+Roster::Roster() = default;
+
+/**
+ * @brief Adiciona um aluno, mantendo o vetor ordenado.
+ * Complexidade: O(N).
+ * @param studentCode - Número UP do aluno.
+ * @return Verdadeiro se o aluno foi adicionado, falso se já existia.
+ */
+bool Roster::insert(unsigned int studentCode) {
+    auto it = std::lower_bound(_studentCodes.begin(), _studentCodes.end(), studentCode);
+    if (it != _studentCodes.end() && *it == studentCode) return false;
+    _studentCodes.insert(it, studentCode);
+    return true;
+}
+
+/**
+ * @brief Remove um aluno.
+ * Complexidade: O(N).
+ * @param studentCode - Número UP do aluno.
+ * @return Verdadeiro se o aluno foi removido, falso se não existia.
+ */
+bool Roster::erase(unsigned int studentCode) {
+    auto it = std::lower_bound(_studentCodes.begin(), _studentCodes.end(), studentCode);
+    if (it == _studentCodes.end() || *it != studentCode) return false;
+    _studentCodes.erase(it);
+    return true;
+}
+
+/**
+ * @brief Verifica se um aluno pertence à lista.
+ * Complexidade: O(logN).
+ * @param studentCode - Número UP do aluno.
+ * @return Verdadeiro se o aluno pertencer à lista.
+ */
+bool Roster::contains(unsigned int studentCode) const {
+    return std::binary_search(_studentCodes.begin(), _studentCodes.end(), studentCode);
+}
+
+/**
+ * @brief Permite obter o número de alunos.
+ * Complexidade: O(1).
+ * @return Número de alunos.
+ */
+size_t Roster::size() const {
+    return _studentCodes.size();
+}
+
+/**
+ * @brief Verifica se a lista está vazia.
+ * Complexidade: O(1).
+ * @return Verdadeiro se não tiver alunos.
+ */
+bool Roster::empty() const {
+    return _studentCodes.empty();
+}
+
+/**
+ * @brief Início dos números UP, por ordem crescente.
+ * Complexidade: O(1).
+ */
+std::vector<unsigned int>::const_iterator Roster::begin() const {
+    return _studentCodes.begin();
+}
+
+/**
+ * @brief Fim dos números UP.
+ * Complexidade: O(1).
+ */
+std::vector<unsigned int>::const_iterator Roster::end() const {
+    return _studentCodes.end();
+}
+
+/**
+ * @brief Estima a memória dinâmica ocupada pela lista.
+ * Complexidade: O(1).
+ * @return Número de bytes.
+ */
+size_t Roster::memoryUsage() const {
+    return MemoryUsage::vectorBuffer(_studentCodes);
+}
+
+/**
+ * @brief Calcula a união de várias listas, juntando-as duas a duas (como no merge sort).
+ * Complexidade: O(N logK), sendo N o número total de alunos e K o número de listas.
+ * @param rosters - Listas a unir.
+ * @return Números UP de todos os alunos, por ordem crescente e sem repetições.
+ */
+std::vector<unsigned int> Roster::unite(const std::vector<const Roster *> &rosters) {
+    std::vector<std::vector<unsigned int>> parts;
+    parts.reserve(rosters.size());
+    for (const Roster *roster: rosters) parts.push_back(roster->_studentCodes);
+    if (parts.empty()) return {};
+
+    while (parts.size() > 1) {
+        std::vector<std::vector<unsigned int>> merged;
+        merged.reserve((parts.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < parts.size(); i += 2) {
+            std::vector<unsigned int> part;
+            part.reserve(parts[i].size() + parts[i + 1].size());
+            std::set_union(parts[i].begin(), parts[i].end(), parts[i + 1].begin(), parts[i + 1].end(),
+                           std::back_inserter(part));
+            merged.push_back(std::move(part));
+        }
+        if (parts.size() % 2 == 1) merged.push_back(std::move(parts.back()));
+        parts = std::move(merged);
+    }
+    return std::move(parts.front());
+}
+
+/**
+ * @brief Calcula a interseção de várias listas, começando pela mais pequena.
+ * Complexidade: O(N), sendo N o número total de alunos.
+ * @param rosters - Listas a intersetar.
+ * @return Números UP dos alunos presentes em todas as listas, por ordem crescente.
+ */
+std::vector<unsigned int> Roster::intersect(const std::vector<const Roster *> &rosters) {
+    if (rosters.empty()) return {};
+    std::vector<const Roster *> sorted(rosters);
+    std::sort(sorted.begin(), sorted.end(), [](const Roster *a, const Roster *b) { return a->size() < b->size(); });
+
+    std::vector<unsigned int> result = sorted.front()->_studentCodes, next;
+    for (size_t i = 1; i < sorted.size() && !result.empty(); i++) {
+        next.clear();
+        std::set_intersection(result.begin(), result.end(), sorted[i]->begin(), sorted[i]->end(),
+                              std::back_inserter(next));
+        result.swap(next);
+    }
+    return result;
+}
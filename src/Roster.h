@@ -0,0 +1,45 @@
+#ifndef PROJECT_1_SCHEDULE_ROSTER_H
+#define PROJECT_1_SCHEDULE_ROSTER_H
+
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Classe que representa a lista de alunos de uma turma, guardada como um vetor ordenado de números UP
+ * (4 bytes por aluno, em memória contígua). A ordem permite pesquisa binária e uniões e interseções lineares entre
+ * turmas.
+ */
+
+class Roster {
+public:
+
+    Roster();
+
+    bool insert(unsigned int studentCode);
+
+    bool erase(unsigned int studentCode);
+
+    [[nodiscard]] bool contains(unsigned int studentCode) const;
+
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] bool empty() const;
+
+    [[nodiscard]] std::vector<unsigned int>::const_iterator begin() const;
+
+    [[nodiscard]] std::vector<unsigned int>::const_iterator end() const;
+
+    [[nodiscard]] size_t memoryUsage() const;
+
+    static std::vector<unsigned int> unite(const std::vector<const Roster *> &rosters);
+
+    static std::vector<unsigned int> intersect(const std::vector<const Roster *> &rosters);
+
+private:
+    /** @brief Números UP dos alunos, por ordem crescente e sem repetições. */
+    std::vector<unsigned int> _studentCodes;
+};
+
+
+#endif //PROJECT_1_SCHEDULE_ROSTER_H
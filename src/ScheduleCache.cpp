@@ -0,0 +1,143 @@
+#include "ScheduleCache.h"
+#include "MemoryUsage.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace {
+    /**
+     * @brief Procura uma chave num mapa de horários.
+     * Complexidade: O(log N).
+     * @param entries - Horários.
+     * @param key - Chave.
+     * @return Apontador para o horário, ou nullptr se não estiver guardado.
+     */
+    template<typename Key>
+    const ScheduleCache::Entry *findEntry(const std::map<Key, ScheduleCache::Entry> &entries, const Key &key) {
+        auto it = entries.find(key);
+        return it == entries.end() ? nullptr : &it->second;
+    }
+
+    /**
+     * @brief Estima a memória de um mapa de horários.
+     * Complexidade: O(N).
+     * @param entries - Horários.
+     * @return Número de bytes.
+     */
+    template<typename Key>
+    size_t entriesMemoryUsage(const std::map<Key, ScheduleCache::Entry> &entries) {
+        size_t bytes = 0;
+        for (const auto &pair: entries) {
+            bytes += MemoryUsage::treeNode(sizeof(pair)) + MemoryUsage::vectorBuffer(pair.second.lessons) +
+                     MemoryUsage::string(pair.second.text);
+            if constexpr (std::is_same_v<Key, std::string>) bytes += MemoryUsage::string(pair.first);
+        }
+        return bytes;
+    }
+}
+
+/**
+ * @brief Construtor default da classe ScheduleCache.
+ * Complexidade: O(1).
+ */
+ScheduleCache::ScheduleCache() = default;
+
+/**
+ * @brief Procura o horário guardado de um aluno.
+ * Complexidade: O(log N).
+ * @param studentCode - Número UP do aluno.
+ * @return Apontador para o horário, ou nullptr se não estiver guardado.
+ */
+const ScheduleCache::Entry *ScheduleCache::findStudent(unsigned int studentCode) const {
+    return findEntry(_students, studentCode);
+}
+
+/**
+ * @brief Procura o horário guardado de uma turma.
+ * Complexidade: O(log N).
+ * @param classCode - Código da turma.
+ * @return Apontador para o horário, ou nullptr se não estiver guardado.
+ */
+const ScheduleCache::Entry *ScheduleCache::findClass(const std::string &classCode) const {
+    return findEntry(_classes, classCode);
+}
+
+/**
+ * @brief Procura o horário guardado de uma unidade curricular.
+ * Complexidade: O(log N).
+ * @param ucCode - Código da UC.
+ * @return Apontador para o horário, ou nullptr se não estiver guardado.
+ */
+const ScheduleCache::Entry *ScheduleCache::findUc(const std::string &ucCode) const {
+    return findEntry(_ucs, ucCode);
+}
+
+/**
+ * @brief Guarda o horário de um aluno.
+ * Complexidade: O(log N).
+ * @param studentCode - Número UP do aluno.
+ * @param entry - Horário.
+ * @return Horário guardado.
+ */
+const ScheduleCache::Entry &ScheduleCache::storeStudent(unsigned int studentCode, Entry entry) {
+    return _students[studentCode] = std::move(entry);
+}
+
+/**
+ * @brief Guarda o horário de uma turma.
+ * Complexidade: O(log N).
+ * @param classCode - Código da turma.
+ * @param entry - Horário.
+ * @return Horário guardado.
+ */
+const ScheduleCache::Entry &ScheduleCache::storeClass(const std::string &classCode, Entry entry) {
+    return _classes[classCode] = std::move(entry);
+}
+
+/**
+ * @brief Guarda o horário de uma unidade curricular.
+ * Complexidade: O(log N).
+ * @param ucCode - Código da UC.
+ * @param entry - Horário.
+ * @return Horário guardado.
+ */
+const ScheduleCache::Entry &ScheduleCache::storeUc(const std::string &ucCode, Entry entry) {
+    return _ucs[ucCode] = std::move(entry);
+}
+
+/**
+ * @brief Remove o horário guardado de um aluno, para que seja recalculado no próximo pedido.
+ * Complexidade: O(log N).
+ * @param studentCode - Número UP do aluno.
+ */
+void ScheduleCache::invalidateStudent(unsigned int studentCode) {
+    _students.erase(studentCode);
+}
+
+/**
+ * @brief Remove todos os horários guardados.
+ * Complexidade: O(N).
+ */
+void ScheduleCache::clear() {
+    _students.clear();
+    _classes.clear();
+    _ucs.clear();
+}
+
+/**
+ * @brief Permite obter o número de horários guardados.
+ * Complexidade: O(1).
+ * @return Número de horários.
+ */
+size_t ScheduleCache::size() const {
+    return _students.size() + _classes.size() + _ucs.size();
+}
+
+/**
+ * @brief Estima a memória dinâmica ocupada pela cache.
+ * Complexidade: O(N).
+ * @return Número de bytes.
+ */
+size_t ScheduleCache::memoryUsage() const {
+    return entriesMemoryUsage(_students) + entriesMemoryUsage(_classes) + entriesMemoryUsage(_ucs);
+}
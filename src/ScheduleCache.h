@@ -0,0 +1,60 @@
+#ifndef PROJECT_1_SCHEDULE_SCHEDULECACHE_H
+#define PROJECT_1_SCHEDULE_SCHEDULECACHE_H
+
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Lesson.h"
+
+/**
+ * @brief Cache dos horários já pedidos: para cada aluno, turma e unidade curricular guarda as aulas ordenadas e o
+ * texto do horário já formatado.
+ * As aulas são guardadas como apontadores para as aulas das turmas, que só mudam quando as turmas são carregadas
+ * (altura em que a cache é limpa). Os horários das turmas e das unidades curriculares não dependem dos alunos
+ * inscritos; o horário de um aluno é invalidado sempre que as suas inscrições mudam.
+ */
+
+class ScheduleCache {
+public:
+    /** @brief Horário guardado. */
+    struct Entry {
+        /** @brief Aulas, por ordem de dia e de hora de início. */
+        std::vector<const Lesson *> lessons;
+        /** @brief Texto do horário, uma linha por aula, com o dia da semana antes da primeira aula de cada dia. */
+        std::string text;
+    };
+
+    ScheduleCache();
+
+    [[nodiscard]] const Entry *findStudent(unsigned int studentCode) const;
+
+    [[nodiscard]] const Entry *findClass(const std::string &classCode) const;
+
+    [[nodiscard]] const Entry *findUc(const std::string &ucCode) const;
+
+    const Entry &storeStudent(unsigned int studentCode, Entry entry);
+
+    const Entry &storeClass(const std::string &classCode, Entry entry);
+
+    const Entry &storeUc(const std::string &ucCode, Entry entry);
+
+    void invalidateStudent(unsigned int studentCode);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] size_t memoryUsage() const;
+
+private:
+    /** @brief Horários dos alunos, por número UP. */
+    std::map<unsigned int, Entry> _students;
+    /** @brief Horários das turmas, por código de turma. */
+    std::map<std::string, Entry> _classes;
+    /** @brief Horários das unidades curriculares, por código de UC. */
+    std::map<std::string, Entry> _ucs;
+};
+
+
+#endif //PROJECT_1_SCHEDULE_SCHEDULECACHE_H
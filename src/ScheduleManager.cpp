@@ -2,24 +2,147 @@
 #include <fstream>
 #include <sstream>
 #include "ScheduleManager.h"
+#include "Instrumentation.h"
+#include "MemoryUsage.h"
+#include "FieldParser.h"
+#include "Tracer.h"
+#include "CohortPlacer.h"
+#include "ClassRebalancer.h"
+
+namespace {
+#ifdef SCHEDULE_INSTRUMENTATION
+    /**
+     * @brief Descreve um pedido para os eventos do Tracer (aluno, UC e turma).
+     */
+    std::string traceDetail(const Requests &request) {
+        return "up" + std::to_string(request.getStudent().getStudentCode()) + " " +
+               request.getDesiredClass().getUcCode() + " " + request.getDesiredClass().getClassCode();
+    }
+#endif
+
+    /**
+     * @brief Obtém a chave de uma linha de um ficheiro CSV, formada pelas primeiras 'keyFields' colunas.
+     * Complexidade: O(N), sendo N o tamanho da linha.
+     */
+    std::string lineKey(const std::string &linha, unsigned int keyFields) {
+        size_t end = std::string::npos, from = 0;
+        for (unsigned int i = 0; i < keyFields; i++) {
+            end = linha.find(',', from);
+            if (end == std::string::npos) break;
+            from = end + 1;
+        }
+        return linha.substr(0, end);
+    }
+
+    /**
+     * @brief Primeira passagem sobre um ficheiro CSV (sem o cabeçalho): obtém o número de linhas de cada sequência de
+     * linhas consecutivas com a mesma chave, voltando depois ao início dos dados.
+     * Complexidade: O(N), sendo N o tamanho do ficheiro.
+     */
+    std::vector<unsigned int> countRuns(std::istream &arquivo, unsigned int keyFields) {
+        std::vector<unsigned int> runs;
+        std::streampos dados = arquivo.tellg();
+        std::string linha, anterior;
+        while (std::getline(arquivo, linha)) {
+            std::string chave = lineKey(linha, keyFields);
+            if (runs.empty() || chave != anterior) runs.push_back(0);
+            runs.back()++;
+            anterior = std::move(chave);
+        }
+        arquivo.clear();
+        arquivo.seekg(dados);
+        return runs;
+    }
+}
+
+UcCatalog ScheduleManager::_catalog;
 
 /**
  * @brief Construtor da classe ScheduleManager.
  * Complexidade: O(1).
  */
-ScheduleManager::ScheduleManager() = default;
+ScheduleManager::ScheduleManager() : _students(&_arena), _classes(&_arena) {}
+
+/**
+ * @brief Permite carregar o catálogo das unidades curriculares de um ficheiro CSV (UcCode,UcName,Year,Credits).
+ * Se o ficheiro não existir é usado o catálogo interno da L.EIC. Deve ser chamado depois de load_classes().
+ * Complexidade: O(N).
+ * @param file
+ * @return Verdadeiro se o catálogo foi lido do ficheiro, falso se foi usado o catálogo interno.
+ */
+bool ScheduleManager::load_ucs(const std::string &file) {
+    SCHEDULE_LATENCY();
+    bool loaded = _catalog.load(file);
+    if (!loaded) _catalog.loadBuiltin();
+    _scheduleCache.clear();
+    return loaded;
+}
+
+/**
+ * @brief Permite carregar a capacidade máxima de cada turma de um ficheiro CSV (ClassCode,UcCode,Capacity).
+ * As turmas que não constam do ficheiro (ou todas, se o ficheiro não existir) ficam com Class::DEFAULT_CAPACITY
+ * alunos. As linhas cuja capacidade não é um inteiro sem sinal válido (negativa, fora do intervalo ou com outros
+ * caracteres) são ignoradas e contadas num aviso. Deve ser chamado depois de load_students_classes().
+ * Complexidade: O(N log C + C log C), sendo N o número de linhas e C o número de turmas.
+ * @param file
+ * @return Verdadeiro se o ficheiro foi lido, falso caso contrário.
+ */
+bool ScheduleManager::load_capacities(const std::string &file) {
+    SCHEDULE_LATENCY();
+    std::ifstream arquivo(file);
+    if (!arquivo.is_open()) return false;
+    std::string linha;
+    std::getline(arquivo, linha);
+    unsigned int invalid = 0;
+
+    while (std::getline(arquivo, linha)) {
+        if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+        std::stringstream linhaStream(linha);
+        std::string classCode, ucCode, capacity;
+        if (!(std::getline(linhaStream, classCode, ',')
+              && std::getline(linhaStream, ucCode, ',')
+              && std::getline(linhaStream, capacity, ','))) {
+            continue;
+        }
+        unsigned int value;
+        if (!FieldParser::parseUnsigned(capacity, value)) {
+            invalid++;
+            continue;
+        }
+        Class *turma = findClass(UCSpecificClass(classCode, ucCode));
+        if (turma != nullptr) turma->setCapacity(value);
+    }
+    if (invalid > 0) std::cerr << invalid << " linhas com capacidade inválida ignoradas em " << file << std::endl;
+    rebuildOccupancy();
+    return true;
+}
 
 /**
  * @brief Permite carregar as turmas e as aulas de um ficheiro CSV.
+ * Uma primeira passagem conta as linhas, para reservar na arena o espaço de todas as turmas e aulas e o tamanho exato
+ * do vetor de aulas de cada turma (quando as aulas de uma turma estão seguidas no ficheiro).
  * Complexidade: O(N logN).
  * @param file
  */
 void ScheduleManager::load_classes(const std::string &file) {
+    SCHEDULE_LATENCY();
+    SCHEDULE_TRACE_SPAN("load_classes");
     std::ifstream arquivo(file);
     std::string linha;
     std::getline(arquivo, linha);
 
+    std::vector<unsigned int> runs = countRuns(arquivo, 2);
+    size_t lessons = 0;
+    for (unsigned int run: runs) lessons += run;
+    _arena.reserve(runs.size() * (MemoryUsage::TREE_NODE_HEADER + sizeof(std::pair<const UCSpecificClass, Class>)) +
+                   lessons * sizeof(Lesson));
+    size_t run = 0;
+    std::string anterior;
+
     while (std::getline(arquivo, linha)) {
+        std::string chave = lineKey(linha, 2);
+        if (chave != anterior && !anterior.empty()) run++;
+        anterior = std::move(chave);
         std::stringstream linhaStream(linha);
         std::string classCode, ucCode, weekDay, startHour, Duration, classType;
         if (std::getline(linhaStream, classCode, ',')
@@ -32,27 +155,45 @@ void ScheduleManager::load_classes(const std::string &file) {
             UCSpecificClass ucSpecificClass(classCode, ucCode);
             Lesson lesson(weekDay, std::stof(startHour), std::stof(Duration), classType, ucSpecificClass);
 
-            if (_classes.find(ucSpecificClass) == _classes.end()) {
-                _classes[ucSpecificClass] = Class(ucSpecificClass, std::vector<Lesson>{});
+            auto it = _classes.find(ucSpecificClass);
+            if (it == _classes.end()) {
+                it = _classes.emplace(ucSpecificClass, Class(ucSpecificClass)).first;
+                it->second.reserveLessons(runs[run]);
             }
-            _classes[ucSpecificClass].addLesson(lesson);
+            it->second.addLesson(lesson);
 
         }
     }
+    _scheduleCache.clear();
 }
 
 /**
  * @brief Permite carregar os estudantes e as suas turmas de um ficheiro CSV.
+ * Uma primeira passagem conta as linhas, para reservar na arena o espaço de todos os estudantes e o tamanho exato do
+ * vetor de turmas de cada estudante (quando as linhas de um estudante estão seguidas no ficheiro). No fim, a tabela de
+ * estudantes é ordenada e indexada por número UP e é construída a tabela das aulas (só agora, para que os
+ * identificadores compactos das turmas continuem a ser atribuídos pela ordem do ficheiro dos estudantes).
  * Complexidade: O(N logN).
  * @param file
  */
 void ScheduleManager::load_students_classes(const std::string &file) {
+    SCHEDULE_LATENCY();
+    SCHEDULE_TRACE_SPAN("load_students_classes");
     std::ifstream arquivo(file);
     std::string linha;
+    _studentsClassesFile = file;
 
     std::getline(arquivo, linha);
 
+    std::vector<unsigned int> runs = countRuns(arquivo, 1);
+    _students.reserve(_students.size() + runs.size());
+    size_t run = 0;
+    std::string anterior;
+
     while (std::getline(arquivo, linha)) {
+        std::string chave = lineKey(linha, 1);
+        if (chave != anterior && !anterior.empty()) run++;
+        anterior = std::move(chave);
         std::stringstream linhaStream(linha);
         std::string studentCode, studentName, ucCode, classCode;
         if (std::getline(linhaStream, studentCode, ',')
@@ -63,10 +204,9 @@ void ScheduleManager::load_students_classes(const std::string &file) {
             classCode.pop_back();
             unsigned studentCodeInt = std::stoi(studentCode);
 
-            if (_students.find(studentCodeInt) == _students.end()) {
-                _students.emplace(studentCodeInt, Student(studentCodeInt, studentName));
-            }
-            _students[studentCodeInt].addTurma(UCSpecificClass(classCode, ucCode));
+            Student &student = _students.add(studentCodeInt, studentName);
+            if (student.getTurmaIds().empty()) student.reserveTurmas(runs[run]);
+            student.addTurma(UCSpecificClass(classCode, ucCode));
 
             auto it = _classes.find(UCSpecificClass(classCode, ucCode));
             if (it != _classes.end()) {
@@ -74,6 +214,187 @@ void ScheduleManager::load_students_classes(const std::string &file) {
             }
         }
     }
+    _students.build();
+    rebuildUcCountHistogram();
+    rebuildOccupancy();
+    _lessonTable.build(_classes);
+    rebuildCoEnrollment();
+    _scheduleCache.clear();
+}
+
+/**
+ * @brief Permite carregar pedidos de um ficheiro CSV (Type,StudentCode,UcCode,ClassCode,CurrentUcCode).
+ * Os pedidos são validados da mesma forma que na submissão pelo menu; os inválidos são ignorados, e as linhas com um
+ * número UP que não é um inteiro válido são ignoradas e contadas num aviso.
+ * Complexidade: O(N logN).
+ * @param file
+ * @return Número de pedidos adicionados às filas.
+ */
+unsigned int ScheduleManager::load_requests(const std::string &file) {
+    SCHEDULE_LATENCY();
+    SCHEDULE_TRACE_SPAN("load_requests");
+    std::ifstream arquivo(file);
+    if (!arquivo.is_open()) {
+        std::cerr << "Não foi possível abrir " << file << std::endl;
+        return 0;
+    }
+    std::string linha;
+    unsigned int count = 0, invalid = 0;
+
+    std::getline(arquivo, linha);
+
+    while (std::getline(arquivo, linha)) {
+        if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+        std::stringstream linhaStream(linha);
+        std::string type, studentCode, ucCode, classCode, ucCurrent;
+        if (!(std::getline(linhaStream, type, ',')
+              && std::getline(linhaStream, studentCode, ',')
+              && std::getline(linhaStream, ucCode, ',')
+              && std::getline(linhaStream, classCode, ','))) {
+            continue;
+        }
+        std::getline(linhaStream, ucCurrent, ',');
+
+        unsigned int code;
+        if (!FieldParser::parseUnsigned(studentCode, code)) {
+            invalid++;
+            continue;
+        }
+        Student *student = findStudent(code);
+        if (student == nullptr) continue;
+        UCSpecificClass ucSpecificClass(classCode, ucCode);
+
+        if (type == "Removal") {
+            if (!student->isEnrolledUc(ucCode)) continue;
+            addRemovalRequest(*student, student->findUCSpecificClass(ucCode));
+        } else if (findClass(ucSpecificClass) == nullptr) {
+            continue;
+        } else if (type == "Enrollment") {
+            if (student->isEnrolledUc(ucCode)) continue;
+            addEnrollmentRequest(*student, ucSpecificClass);
+        } else if (type == "Change Class") {
+            if (!student->isEnrolledUc(ucCode)) continue;
+            addChangeClassRequest(*student, ucSpecificClass);
+        } else if (type == "Change Uc") {
+            if (!student->isEnrolledUc(ucCurrent) || student->isEnrolledUc(ucCode)) continue;
+            addChangeUcRequest(*student, ucSpecificClass, ucCurrent);
+        } else {
+            continue;
+        }
+        count++;
+    }
+    if (invalid > 0) std::cerr << invalid << " linhas com número UP inválido ignoradas em " << file << std::endl;
+    return count;
+}
+
+/**
+ * @brief Inscreve de uma só vez um grupo de alunos (por exemplo, os novos alunos do 1.º ano) nas UCs indicadas num
+ * ficheiro CSV (StudentCode,StudentName,UcCode), com uma linha por aluno e UC. Os alunos que ainda não existem são
+ * criados.
+ * Em vez de processar um pedido de inscrição de cada vez (o que depende da ordem dos pedidos), todos os alunos são
+ * colocados em conjunto pelo CohortPlacer: sem sobreposições, sem exceder a capacidade das turmas e com as turmas de
+ * cada UC equilibradas. Cada aluno fica inscrito em todas as UCs pedidas ou em nenhuma. As inscrições ficam na pilha
+ * dos pedidos aceites, para poderem ser anuladas. As linhas com um número UP inválido são ignoradas.
+ * Complexidade: O(N * A + M), sendo N o número de alunos, A o número máximo de combinações tentadas por aluno e M o
+ * número de mudanças de turma do balanceamento.
+ * @param file
+ * @return Número de inscrições feitas.
+ */
+unsigned int ScheduleManager::enrollCohort(const std::string &file) {
+    SCHEDULE_LATENCY();
+    SCHEDULE_TRACE_SPAN("enrollCohort");
+    std::ifstream arquivo(file);
+    if (!arquivo.is_open()) {
+        std::cerr << "Não foi possível abrir " << file << std::endl;
+        return 0;
+    }
+    std::string linha;
+    std::getline(arquivo, linha);
+    unsigned int invalid = 0;
+
+    std::vector<unsigned int> codes;
+    std::map<unsigned int, std::vector<std::string>> wanted;
+    while (std::getline(arquivo, linha)) {
+        if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+        std::stringstream linhaStream(linha);
+        std::string studentCode, studentName, ucCode;
+        if (!(std::getline(linhaStream, studentCode, ',')
+              && std::getline(linhaStream, studentName, ',')
+              && std::getline(linhaStream, ucCode, ','))) {
+            continue;
+        }
+        unsigned int code;
+        if (!FieldParser::parseUnsigned(studentCode, code)) {
+            invalid++;
+            continue;
+        }
+        std::vector<std::string> &ucs = wanted[code];
+        if (ucs.empty()) {
+            codes.push_back(code);
+            _students.add(code, studentName);
+        }
+        if (std::find(ucs.begin(), ucs.end(), ucCode) == ucs.end()) ucs.push_back(ucCode);
+    }
+    if (invalid > 0) std::cerr << invalid << " linhas com número UP inválido ignoradas em " << file << std::endl;
+    _students.build();
+    rebuildUcCountHistogram();
+    rebuildCoEnrollment();
+    _scheduleCache.clear();
+
+    std::map<uint16_t, uint32_t> ucIndex;
+    std::vector<std::vector<CohortClass>> classesOfUc;
+    auto indexOf = [&](uint16_t ucId) {
+        auto it = ucIndex.find(ucId);
+        if (it != ucIndex.end()) return it->second;
+        std::vector<CohortClass> classes;
+        for (uint32_t id: _lessonTable.compatibleClasses(ucId, {})) {
+            UCSpecificClass ucClass = UCSpecificClass::fromId(id);
+            classes.push_back({id, _lessonTable.busyMask({id}),
+                               static_cast<unsigned int>(_classes.at(ucClass).getStudentsIDs().size()),
+                               maxCapacity(ucClass)});
+        }
+        classesOfUc.push_back(std::move(classes));
+        return ucIndex[ucId] = classesOfUc.size() - 1;
+    };
+
+    std::vector<std::vector<uint32_t>> ucsOfStudent, keptOfStudent;
+    for (unsigned int code: codes) {
+        const Student &student = _students.at(code);
+        std::vector<uint32_t> ucs, kept(student.getTurmaIds().begin(), student.getTurmaIds().end());
+        for (const std::string &ucCode: wanted[code]) {
+            int ucId = UCSpecificClass::findUcId(ucCode);
+            if (ucId >= 0 && !student.isEnrolledUc(ucCode)) ucs.push_back(indexOf(ucId));
+        }
+        ucsOfStudent.push_back(std::move(ucs));
+        keptOfStudent.push_back(std::move(kept));
+    }
+    CohortPlacer placer(std::move(classesOfUc), _lessonTable);
+    for (size_t i = 0; i < codes.size(); i++) placer.addStudent(keptOfStudent[i], ucsOfStudent[i]);
+    placer.place();
+
+    unsigned int enrolled = 0;
+    for (size_t i = 0; i < codes.size(); i++) {
+        Student &student = _students.at(codes[i]);
+        for (uint32_t id: placer.placement(i)) {
+            UCSpecificClass ucClass = UCSpecificClass::fromId(id);
+            enroll(student, ucClass);
+            _acceptedRequests.emplace(student, ucClass, "Removal");
+            enrolled++;
+        }
+    }
+    std::cout << "Inscrição em bloco: " << codes.size() - placer.unplacedStudents() << " de " << codes.size()
+              << " alunos colocados (" << enrolled << " inscrições, " << placer.repairMoves()
+              << " mudanças na reparação, " << placer.balanceMoves() << " no balanceamento)." << std::endl;
+    return enrolled;
+}
+
+/**
+ * @brief Permite alterar o ficheiro CSV onde são guardadas as turmas dos estudantes após o processamento.
+ * Complexidade: O(1).
+ * @param file
+ */
+void ScheduleManager::setStudentsClassesFile(const std::string &file) {
+    _studentsClassesFile = file;
 }
 
 /**
@@ -82,23 +403,27 @@ void ScheduleManager::load_students_classes(const std::string &file) {
  * @return Número de identificação do estudante.
  */
  unsigned int ScheduleManager::displayAllStudents() {
+    SCHEDULE_LATENCY();
     system("clear");
-    std::cout << "Estudantes inscritos" << std::endl;
-    std::cout << "--------------------" << std::endl;
     int counter = 0;
-    std::map<int, Student> students;
-    for (const auto &student: _students) {
-        std::cout << ++counter << ". " << student.first << ' ' << student.second.getName() << std::endl;
-        students[counter] = student.second;
+    {
+        OutputBuffer out = listing();
+        out << "Estudantes inscritos\n";
+        out << "--------------------\n";
+        for (const Student &student: _students) {
+            out << ++counter << ". " << student.getStudentCode() << ' ' << student.getName() << '\n';
+        }
     }
     int choice;
     while (true) {
         std::cout << std::endl << "Escolha o aluno desejado." << std::endl;
         std::cout << ">>> ";
+        SCHEDULE_LATENCY_PAUSE();
         std::cin >> choice;
+        SCHEDULE_LATENCY_RESUME();
         if (choice > 0 && choice <= counter) {
             system("clear");
-            return students[choice].getStudentCode();
+            return (_students.begin() + (choice - 1))->getStudentCode();
         }
         std::cout << "Por favor, introduza um dígito válido." << std::endl;
     }
@@ -106,18 +431,22 @@ void ScheduleManager::load_students_classes(const std::string &file) {
 }
 
 /**
- * @brief Mostra o número de alunos inscritos em pelo menos 'n' unidades curriculares.
- * Complexidade: O(N).
+ * @brief Mostra o número de alunos inscritos em pelo menos 'n' unidades curriculares e a distribuição do número de
+ * unidades curriculares por aluno.
+ * Complexidade: O(K), sendo K o maior número de unidades curriculares de um aluno.
  * @param n
  */
 void ScheduleManager::displayStudentsWithNUcs(int n) {
+    SCHEDULE_LATENCY();
     system("clear");
-    unsigned int count = 0;
-    for (const auto &student: _students) {
-        if (student.second.getTurmas().size() >= n)
-            count++;
-    }
-    std::cout << "Estão inscritos " << count << " alunos em pelo menos " << n << " unidades curriculares." << std::endl;
+    std::cout << "Estão inscritos " << countStudentsWithAtLeast(n) << " alunos em pelo menos " << n
+              << " unidades curriculares." << std::endl;
+    std::cout << "Distribuição:" << std::endl;
+    std::vector<unsigned int> histogram = getUcCountHistogram();
+    for (size_t ucs = 0; ucs < histogram.size(); ucs++) {
+        std::cout << "  " << ucs << " UCs: " << histogram[ucs] << " alunos" << std::endl;
+    }
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
@@ -126,38 +455,19 @@ void ScheduleManager::displayStudentsWithNUcs(int n) {
 
 /**
  * @brief Mostra o horário de um aluno.
- * Complexidade: O(N^2).
+ * Complexidade: O(log N) se o horário estiver em cache, O(L log L) caso contrário, sendo L o número de aulas.
  * @param up
  */
 void ScheduleManager::displayScheduleOfAStudent(unsigned int up) {
+    SCHEDULE_LATENCY();
 
     system("clear");
-    std::vector<Lesson> lessonsOfWeek;
-    for (const auto &turmas: _students[up].getTurmas()) {
-        for (const auto &aula: _classes[turmas].getLessons()) {
-            lessonsOfWeek.push_back(aula);
-        }
-    }
-
-    std::sort(lessonsOfWeek.begin(), lessonsOfWeek.end());
+    const ScheduleCache::Entry &schedule = studentSchedule(up);
 
     std::cout << "Horário do aluno " << up << " - " << _students.at(up).getName() << std::endl;
     std::cout << "---------------------------------------------" << std::endl;
-
-    int currentDay = -1;
-
-    for (const Lesson &lesson: lessonsOfWeek) {
-        if (lesson.getDayValue() != currentDay) {
-            currentDay = lesson.getDayValue();
-            std::cout << lesson.getWeekDay() << ":" << std::endl;
-        }
-
-        std::cout << ScheduleManager::normalizeHours(lesson.getStartTime()) << " to "
-                  << ScheduleManager::normalizeHours(lesson.getStartTime() + lesson.getDuration()) << " -> "
-                  << lesson.getUcSpecificClass().getClassCode() << ' '
-                  << ucCodeToName(lesson.getUcSpecificClass().getUcCode()) << " ("
-                  << lesson.getUcType() << ")" << std::endl;
-    }
+    std::cout << schedule.text;
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
@@ -166,38 +476,17 @@ void ScheduleManager::displayScheduleOfAStudent(unsigned int up) {
 
 /**
  * @brief Mostra o horário de uma turma.
- * Complexidade: O(N^2).
+ * Complexidade: O(log N) se o horário estiver em cache, O(N + L log L) caso contrário.
  * @param classCode
  */
 void ScheduleManager::displayClassSchedule(const std::string &classCode) {
+    SCHEDULE_LATENCY();
     system("clear");
-    std::vector<Lesson> lessonsOfClass;
-
-    for (const auto &pair: _classes) {
-        UCSpecificClass key = pair.first;
-        Class value = pair.second;
-        if (key.getClassCode() == classCode) {
-            for (const Lesson &lesson: value.getLessons()) {
-                lessonsOfClass.push_back(lesson);
-            }
-        }
-    }
-    std::sort(lessonsOfClass.begin(), lessonsOfClass.end());
+    const ScheduleCache::Entry &schedule = classSchedule(classCode);
 
-    int currentDay = -1;
     std::cout << "A turma " << classCode << " tem o seguinte horário:" << std::endl << std::endl;
-    for (const Lesson &lesson: lessonsOfClass) {
-        if (lesson.getDayValue() != currentDay) {
-            currentDay = lesson.getDayValue();
-            std::cout << lesson.getWeekDay() << ":" << std::endl;
-        }
-
-        std::cout << ScheduleManager::normalizeHours(lesson.getStartTime()) << " to "
-                  << ScheduleManager::normalizeHours(lesson.getStartTime() + lesson.getDuration()) << " -> "
-                  << lesson.getUcSpecificClass().getClassCode() << ' '
-                  << ucCodeToName(lesson.getUcSpecificClass().getUcCode()) << " ("
-                  << lesson.getUcType() << ")" << std::endl;
-    }
+    std::cout << schedule.text;
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
@@ -210,13 +499,13 @@ void ScheduleManager::displayClassSchedule(const std::string &classCode) {
  * @param ucClass
  */
 void ScheduleManager::displayStudentsFromClass(const UCSpecificClass &ucClass) {
+    SCHEDULE_LATENCY();
     system("clear");
-    std::set<Student> students;
-    for (auto id: _classes[ucClass].getStudentsIDs()) {
-        students.insert(_students[id]);
-    }
-    ScheduleManager::displaySortedStudents(students);
-    std::cout << "Students: " << students.size() << std::endl;
+    std::vector<const Student *> students = studentsOf(_classes[ucClass].getStudentsIDs());
+    size_t count = students.size();
+    displaySortedStudents(std::move(students));
+    std::cout << "Students: " << count << std::endl;
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
@@ -225,37 +514,14 @@ void ScheduleManager::displayStudentsFromClass(const UCSpecificClass &ucClass) {
 
 /**
  * @brief Mostra o horário de uma unidade curricular.
- * Complexidade: O(N^2).
+ * Complexidade: O(log N) se o horário estiver em cache, O(N + L log L) caso contrário.
  * @param ucCode
  */
 void ScheduleManager::displayCurriculumSchedule(const std::string &ucCode) {
+    SCHEDULE_LATENCY();
 
-    std::vector<Lesson> lessonsOfUc;
-
-    for (const auto &pair: _classes) {
-        UCSpecificClass key = pair.first;
-        Class value = pair.second;
-        if (key.getUcCode() == ucCode) {
-            for (const Lesson &lesson: value.getLessons()) {
-                lessonsOfUc.push_back(lesson);
-            }
-        }
-    }
-    std::sort(lessonsOfUc.begin(), lessonsOfUc.end());
-    int currentDay = -1;
-
-    for (const Lesson &lesson: lessonsOfUc) {
-        if (lesson.getDayValue() != currentDay) {
-            currentDay = lesson.getDayValue();
-            std::cout << lesson.getWeekDay() << ":" << std::endl;
-        }
-
-        std::cout << ScheduleManager::normalizeHours(lesson.getStartTime()) << " to "
-                  << ScheduleManager::normalizeHours(lesson.getStartTime() + lesson.getDuration()) << " -> "
-                  << lesson.getUcSpecificClass().getClassCode() << ' '
-                  << ucCodeToName(lesson.getUcSpecificClass().getUcCode()) << " ("
-                  << lesson.getUcType() << ")" << std::endl;
-    }
+    std::cout << ucSchedule(ucCode).text;
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
@@ -264,21 +530,21 @@ void ScheduleManager::displayCurriculumSchedule(const std::string &ucCode) {
 
 /**
  * @brief Mostra os alunos de uma unidade curricular específica.
- * Complexidade: O(N^2 + N logN).
+ * Complexidade: O(C + N logK), sendo C o número de turmas, N o número de alunos da UC e K o número de turmas da UC.
  * @param ucCode
  */
 void ScheduleManager::displayStudentsFromUC(const std::string &ucCode) {
+    SCHEDULE_LATENCY();
     system("clear");
-    std::set<Student> students;
+    std::vector<const Roster *> rosters;
     for (auto &it: _classes) {
-        if (it.first.getUcCode() == ucCode) {
-            for (auto &studentID: it.second.getStudentsIDs()) {
-                students.insert(_students[studentID]);
-            }
-        }
+        if (it.first.getUcCode() == ucCode) rosters.push_back(&it.second.getStudentsIDs());
     }
-    ScheduleManager::displaySortedStudents(students);
-    std::cout << "Students: " << students.size() << std::endl;
+    std::vector<const Student *> students = studentsOf(Roster::unite(rosters));
+    size_t count = students.size();
+    displaySortedStudents(std::move(students));
+    std::cout << "Students: " << count << std::endl;
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
@@ -286,23 +552,23 @@ void ScheduleManager::displayStudentsFromUC(const std::string &ucCode) {
 }
 
 /**
- * @brief Mostra os alunos do ano desejado, percorrendo todas as turmas.
- * Complexidade: O(N^2 + N logN).
+ * @brief Mostra os alunos do ano desejado, unindo as listas de alunos de todas as turmas desse ano.
+ * Complexidade: O(C + N logK), sendo C o número de turmas, N o número de inscrições do ano e K o número de turmas do
+ * ano.
  * @param year
  */
 void ScheduleManager::displayStudentsPerYear(const std::string &year) {
+    SCHEDULE_LATENCY();
     system("clear");
-    std::set<Student> students_per_year;
-
+    std::vector<const Roster *> rosters;
     for (const auto &pair: _classes) {
-        if (pair.first.getClassCode().find(year) == 0) {
-            for (unsigned int id: pair.second.getStudentsIDs()) {
-                students_per_year.insert(_students[id]);
-            }
-        }
+        if (pair.first.getClassCode().find(year) == 0) rosters.push_back(&pair.second.getStudentsIDs());
     }
-    ScheduleManager::displaySortedStudents(students_per_year);
-    std::cout << "O " << year << "º ano é composto por " << students_per_year.size() << " alunos." << std::endl;
+    std::vector<const Student *> students_per_year = studentsOf(Roster::unite(rosters));
+    size_t count = students_per_year.size();
+    displaySortedStudents(std::move(students_per_year));
+    std::cout << "O " << year << "º ano é composto por " << count << " alunos." << std::endl;
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
@@ -315,6 +581,7 @@ void ScheduleManager::displayStudentsPerYear(const std::string &year) {
  * @return Nome correspondente à unidade curricular.
  */
 std::string ScheduleManager::displayAllUcs() {
+    SCHEDULE_LATENCY();
     system("clear");
     std::cout << "Unidades Curriculares" << std::endl;
     std::cout << "---------------------" << std::endl;
@@ -334,7 +601,9 @@ std::string ScheduleManager::displayAllUcs() {
     while (true) {
         std::cout << "Escolha a unidade curricular desejada." << std::endl;
         std::cout << ">>> ";
+        SCHEDULE_LATENCY_PAUSE();
         std::cin >> choice;
+        SCHEDULE_LATENCY_RESUME();
         if (choice > 0 && choice <= counter) {
             system("clear");
             return mapping[choice];
@@ -350,6 +619,7 @@ std::string ScheduleManager::displayAllUcs() {
  * @return Unidadades curriculares daquele ano.
  */
 std::string ScheduleManager::displaySomeUcs(const char &ano) {
+    SCHEDULE_LATENCY();
     system("clear");
     std::cout << "Unidades Curriculares da turma" << std::endl;
     std::cout << "---------------------" << std::endl;
@@ -366,7 +636,9 @@ std::string ScheduleManager::displaySomeUcs(const char &ano) {
     while (true) {
         std::cout << "Escolha a unidade curricular desejada." << std::endl;
         std::cout << ">>> ";
+        SCHEDULE_LATENCY_PAUSE();
         std::cin >> choice;
+        SCHEDULE_LATENCY_RESUME();
         if (choice > 0 && choice <= counter) {
             system("clear");
             return mapping[choice];
@@ -383,6 +655,7 @@ std::string ScheduleManager::displaySomeUcs(const char &ano) {
  * @return Turmas daquele ano.
  */
 std::string ScheduleManager::displaySomeClasses(const char &ano) {
+    SCHEDULE_LATENCY();
     system("clear");
     std::cout << "Turmas do " << ano << "º ano" << std::endl;
     std::cout << "-----------------" << std::endl;
@@ -405,7 +678,9 @@ std::string ScheduleManager::displaySomeClasses(const char &ano) {
     while (true) {
         std::cout << std::endl << "Escolha a turma desejada." << std::endl;
         std::cout << ">>> ";
+        SCHEDULE_LATENCY_PAUSE();
         std::cin >> choice;
+        SCHEDULE_LATENCY_RESUME();
         if (choice > 0 && choice <= counter) {
             system("clear");
             return mapping[choice];
@@ -415,31 +690,332 @@ std::string ScheduleManager::displaySomeClasses(const char &ano) {
 }
 
 /**
- * @brief Mostra a unidade curricular com mais alunos.
- * Complexidade: O(N).
+ * @brief Mostra a unidade curricular com mais alunos, consultando o índice de ocupação.
+ * Complexidade: O(log N).
  */
 void ScheduleManager::displayMostFilledUc() {
+    SCHEDULE_LATENCY();
     system("clear");
-    std::map<std::string, unsigned> ucs;
-    for (const auto &turma: _classes) {
-        ucs[turma.first.getUcCode()] += turma.second.getStudentsIDs().size();
-    }
     std::string mostFilledUc;
     unsigned mostFilledUcSize = 0;
-    for (const auto &it: ucs) {
-        if (it.second > mostFilledUcSize) {
-            mostFilledUc = it.first;
-            mostFilledUcSize = it.second;
-        }
+    std::vector<OccupancyIndex<std::string>::Entry> top = getMostFilledUcs(1);
+    if (!top.empty() && top.front().second > 0) {
+        mostFilledUc = top.front().first;
+        mostFilledUcSize = top.front().second;
     }
     std::cout << "Unidade Curricular com mais alunos: " << mostFilledUc << std::endl;
     std::cout << "Número de alunos: " << mostFilledUcSize << std::endl;
+    SCHEDULE_LATENCY_STOP();
+    std::cout << "Prima Enter para continuar.";
+    std::cin.ignore();
+    std::cin.get();
+    system("clear");
+}
+
+/**
+ * @brief Mostra as K unidades curriculares e turmas com mais e com menos alunos e as turmas com no máximo 'margin'
+ * lugares livres.
+ * Complexidade: O(K + M + log N), sendo M o número de turmas perto da capacidade.
+ * @param k - Número de unidades curriculares e turmas de cada lista.
+ * @param margin - Número máximo de lugares livres de uma turma listada.
+ */
+void ScheduleManager::displayOccupancy(unsigned int k, unsigned int margin) {
+    SCHEDULE_LATENCY();
+    system("clear");
+    std::cout << "Unidades curriculares com mais alunos:" << std::endl;
+    for (const auto &entry: getMostFilledUcs(k)) {
+        std::cout << "  " << entry.first << " - " << entry.second << " alunos" << std::endl;
+    }
+    std::cout << "Unidades curriculares com menos alunos:" << std::endl;
+    for (const auto &entry: getLeastFilledUcs(k)) {
+        std::cout << "  " << entry.first << " - " << entry.second << " alunos" << std::endl;
+    }
+    std::cout << "Turmas com mais alunos:" << std::endl;
+    for (const auto &entry: getMostFilledClasses(k)) {
+        std::cout << "  " << entry.first.getUcCode() << " " << entry.first.getClassCode() << " - " << entry.second
+                  << " alunos" << std::endl;
+    }
+    std::cout << "Turmas com menos alunos:" << std::endl;
+    for (const auto &entry: getLeastFilledClasses(k)) {
+        std::cout << "  " << entry.first.getUcCode() << " " << entry.first.getClassCode() << " - " << entry.second
+                  << " alunos" << std::endl;
+    }
+    std::vector<OccupancyIndex<UCSpecificClass>::Entry> nearCapacity = getClassesNearCapacity(margin);
+    std::cout << "Turmas com no máximo " << margin << " lugares livres: " << nearCapacity.size() << std::endl;
+    for (auto it = nearCapacity.rbegin(); it != nearCapacity.rend(); it++) {
+        std::cout << "  " << it->first.getUcCode() << " " << it->first.getClassCode() << " - " << it->second << "/"
+                  << maxCapacity(it->first) << std::endl;
+    }
+    SCHEDULE_LATENCY_STOP();
+    std::cout << "Prima Enter para continuar.";
+    std::cin.ignore();
+    std::cin.get();
+    system("clear");
+}
+
+/**
+ * @brief Mostra os intervalos livres comuns a um grupo de alunos, com pelo menos a duração indicada.
+ * Complexidade: O(N * K + C log C), sendo N o número de alunos, K o número de turmas de cada aluno e C o número de
+ * turmas distintas do grupo.
+ * @param studentCodes - Números UP dos alunos.
+ * @param minHours - Duração mínima, em horas.
+ */
+void ScheduleManager::displayCommonFreeTime(const std::vector<unsigned int> &studentCodes, float minHours) {
+    SCHEDULE_LATENCY();
+    system("clear");
+    static const char *const days[] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"};
+    std::vector<FreeWindow> windows = commonFreeTime(studentCodes, minHours);
+    std::cout << "Intervalos livres comuns a " << studentCodes.size() << " alunos, com pelo menos "
+              << normalizeHours(minHours) << " horas (entre as " << normalizeHours(FREE_TIME_START) << " e as "
+              << normalizeHours(FREE_TIME_END) << "):" << std::endl;
+    if (windows.empty()) std::cout << "Nenhum." << std::endl;
+    int currentDay = -1;
+    for (const FreeWindow &window: windows) {
+        if (window.day != currentDay) {
+            currentDay = window.day;
+            std::cout << days[currentDay] << ":" << std::endl;
+        }
+        std::cout << normalizeHours(window.start / 60.0f) << " to " << normalizeHours(window.end / 60.0f) << std::endl;
+    }
+    SCHEDULE_LATENCY_STOP();
+    std::cout << "Prima Enter para continuar.";
+    std::cin.ignore();
+    std::cin.get();
+    system("clear");
+}
+
+/**
+ * @brief Permite obter os intervalos livres comuns a um grupo de alunos (por exemplo, para marcar uma sessão extra).
+ * Em vez de juntar as máscaras da semana aluno a aluno, são juntadas as turmas distintas do grupo, que são muito
+ * menos do que os alunos num grupo grande (todos os alunos de uma UC partilham poucas dezenas de turmas), e a máscara
+ * é calculada uma só vez sobre essas turmas. Contam todas as aulas, incluindo as teóricas.
+ * Complexidade: O(N * K + C log C), sendo N o número de alunos, K o número de turmas de cada aluno e C o número de
+ * turmas distintas do grupo.
+ * @param studentCodes - Números UP dos alunos (os que não existem são ignorados).
+ * @param minHours - Duração mínima, em horas (arredondada para cima à meia hora).
+ * @return Intervalos livres, por dia e hora de início, entre FREE_TIME_START e FREE_TIME_END dos FREE_TIME_DAYS
+ * primeiros dias da semana.
+ */
+std::vector<FreeWindow> ScheduleManager::commonFreeTime(const std::vector<unsigned int> &studentCodes,
+                                                        float minHours) const {
+    std::vector<uint32_t> classIds;
+    for (unsigned int code: studentCodes) {
+        const Student *student = _students.find(code);
+        if (student == nullptr) continue;
+        classIds.insert(classIds.end(), student->getTurmaIds().begin(), student->getTurmaIds().end());
+    }
+    std::sort(classIds.begin(), classIds.end());
+    classIds.erase(std::unique(classIds.begin(), classIds.end()), classIds.end());
+    LessonTable::Mask occupied = _lessonTable.occupiedMask(classIds);
+    auto minSlots = static_cast<unsigned int>(std::ceil(std::max(minHours, 0.0f) * 2));
+    return LessonTable::freeWindows(occupied, minSlots, static_cast<unsigned int>(FREE_TIME_START * 2),
+                                    static_cast<unsigned int>(FREE_TIME_END * 2), FREE_TIME_DAYS);
+}
+
+/**
+ * @brief Permite obter os intervalos livres comuns a todos os alunos de uma turma.
+ * Complexidade: O(N * K + C log C), sendo N o número de alunos da turma, K o número de turmas de cada aluno e C o
+ * número de turmas distintas desses alunos.
+ * @param ucClass - Turma.
+ * @param minHours - Duração mínima, em horas.
+ * @return Intervalos livres, por dia e hora de início.
+ */
+std::vector<FreeWindow> ScheduleManager::commonFreeTime(const UCSpecificClass &ucClass, float minHours) const {
+    auto it = _classes.find(ucClass);
+    if (it == _classes.end()) return {};
+    const Roster &roster = it->second.getStudentsIDs();
+    return commonFreeTime(std::vector<unsigned int>(roster.begin(), roster.end()), minHours);
+}
+
+/**
+ * @brief Mostra o mapa de ocupação semanal: o número de alunos em aula em cada meia hora, entre a primeira e a última
+ * meia hora com alunos, para os dias com aulas.
+ * Complexidade: O(C log C + L + S), sendo C o número de turmas, L o número de aulas e S o número de meias horas da
+ * semana (O(S) sem filtros de ano ou UC).
+ * @param year - Ano das turmas (0 para todos).
+ * @param ucCode - Código da UC (vazio para todas).
+ * @param lessonType - Tipo de aula, T, TP ou PL (vazio para todos).
+ */
+void ScheduleManager::displayOccupancyHeatmap(char year, const std::string &ucCode, const std::string &lessonType) {
+    SCHEDULE_LATENCY();
+    system("clear");
+    static const char *const days[] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+    OccupancyHeatmap::Counts counts = occupancyHeatmap(year, ucCode, lessonType);
+    unsigned int first = LessonTable::SLOTS_PER_DAY, last = 0;
+    std::vector<unsigned int> shownDays;
+    for (unsigned int day = 0; day < LessonTable::DAYS; day++) {
+        bool any = false;
+        for (unsigned int slot = 0; slot < LessonTable::SLOTS_PER_DAY; slot++) {
+            if (counts[day * LessonTable::SLOTS_PER_DAY + slot] == 0) continue;
+            any = true;
+            first = std::min(first, slot);
+            last = std::max(last, slot);
+        }
+        if (any || day < FREE_TIME_DAYS) shownDays.push_back(day);
+    }
+    std::cout << "Alunos em aula por meia hora";
+    if (year != 0) std::cout << " | ano " << year;
+    if (!ucCode.empty()) std::cout << " | UC " << ucCode;
+    if (!lessonType.empty()) std::cout << " | aulas " << lessonType;
+    std::cout << ":" << std::endl;
+    if (first > last) {
+        std::cout << "Nenhum aluno em aula." << std::endl;
+    } else {
+        std::cout << "Hora ";
+        for (unsigned int day: shownDays) std::cout << std::setw(7) << days[day];
+        std::cout << std::endl;
+        for (unsigned int slot = first; slot <= last; slot++) {
+            std::cout << normalizeHours(slot / 2.0f);
+            for (unsigned int day: shownDays) {
+                std::cout << std::setw(7) << counts[day * LessonTable::SLOTS_PER_DAY + slot];
+            }
+            std::cout << std::endl;
+        }
+    }
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
     system("clear");
 }
 
+/**
+ * @brief Permite obter o número de alunos em aula em cada meia hora da semana.
+ * Sem filtros de ano ou UC é usado o mapa mantido incrementalmente (só somando os tipos de aula pedidos), que é
+ * recalculado se tiver sido invalidado; com filtros, o mapa é calculado por varrimento das aulas das turmas escolhidas.
+ * Complexidade: O(S) sem filtros de ano ou UC (O(L + S) se o mapa tiver de ser recalculado); O(K log C + L + S) com
+ * filtros, sendo K o número de turmas escolhidas, L o número de aulas dessas turmas e S o número de meias horas da
+ * semana.
+ * @param year - Ano das turmas, o primeiro carácter do código da turma (0 para todos).
+ * @param ucCode - Código da UC (vazio para todas).
+ * @param lessonType - Tipo de aula, T, TP ou PL (vazio para todos).
+ * @return Número de alunos em cada meia hora (índice dia * LessonTable::SLOTS_PER_DAY + meia hora).
+ */
+OccupancyHeatmap::Counts ScheduleManager::occupancyHeatmap(char year, const std::string &ucCode,
+                                                          const std::string &lessonType) const {
+    unsigned int typeMask = lessonType.empty() ? OccupancyHeatmap::ALL_TYPES : 1u << LessonTable::typeOf(lessonType);
+    if (year == 0 && ucCode.empty()) {
+        if (!_heatmapBuilt) rebuildHeatmap();
+        return _heatmap.counts(typeMask);
+    }
+
+    std::vector<std::pair<uint32_t, int64_t>> classes;
+    if (!ucCode.empty()) {
+        int ucId = UCSpecificClass::findUcId(ucCode);
+        if (ucId < 0) return {};
+        for (uint32_t id: _lessonTable.compatibleClasses(ucId, {})) {
+            UCSpecificClass ucClass = UCSpecificClass::fromId(id);
+            if (year == 0 || ucClass.getClassCode()[0] == year) {
+                classes.emplace_back(id, _classes.at(ucClass).getStudentsIDs().size());
+            }
+        }
+    } else {
+        for (const auto &turma: _classes) {
+            if (turma.first.getClassCode()[0] == year) {
+                classes.emplace_back(turma.first.getId(), turma.second.getStudentsIDs().size());
+            }
+        }
+    }
+    return OccupancyHeatmap::sweep(_lessonTable, classes, typeMask);
+}
+
+/**
+ * @brief Exporta o mapa de ocupação semanal de todas as turmas para um ficheiro CSV (Weekday,Start,End,Students), com
+ * uma linha por meia hora com alunos em aula.
+ * Complexidade: O(S), sendo S o número de meias horas da semana.
+ * @param file
+ * @return Verdadeiro se o ficheiro foi escrito, falso caso contrário.
+ */
+bool ScheduleManager::exportOccupancyHeatmap(const std::string &file) const {
+    static const char *const days[] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"};
+    std::ofstream out(file);
+    if (!out.is_open()) return false;
+    OccupancyHeatmap::Counts counts = occupancyHeatmap();
+    out << "Weekday,Start,End,Students" << std::endl;
+    for (unsigned int day = 0; day < LessonTable::DAYS; day++) {
+        for (unsigned int slot = 0; slot < LessonTable::SLOTS_PER_DAY; slot++) {
+            int64_t students = counts[day * LessonTable::SLOTS_PER_DAY + slot];
+            if (students == 0) continue;
+            out << days[day] << ',' << normalizeHours(slot / 2.0f) << ',' << normalizeHours((slot + 1) / 2.0f) << ','
+                << students << std::endl;
+        }
+    }
+    return out.good();
+}
+
+/**
+ * @brief Mostra as unidades curriculares que partilham alunos com uma unidade curricular, por ordem decrescente do
+ * número de alunos em comum (os exames destas UCs não devem ser marcados à mesma hora).
+ * Complexidade: O(U log U + C), sendo U o número de UCs e C o número de turmas.
+ * @param ucCode - Código da UC.
+ */
+void ScheduleManager::displayCoEnrollment(const std::string &ucCode) {
+    SCHEDULE_LATENCY();
+    system("clear");
+    int ucId = UCSpecificClass::findUcId(ucCode);
+    std::vector<std::pair<unsigned int, std::string>> shared;
+    if (ucId >= 0) {
+        for (const auto &uc: ucsWithClasses()) {
+            unsigned int students = _coEnrollment.common(ucId, uc.second);
+            if (uc.second != ucId && students > 0) shared.emplace_back(students, uc.first);
+        }
+    }
+    std::sort(shared.begin(), shared.end(), [](const auto &a, const auto &b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    std::cout << "A unidade curricular " << ucCode << " tem "
+              << (ucId >= 0 ? _coEnrollment.common(ucId, ucId) : 0) << " alunos." << std::endl;
+    if (shared.empty()) {
+        std::cout << "Nenhum aluno está inscrito noutra unidade curricular." << std::endl;
+    } else {
+        std::cout << "Alunos em comum com outras unidades curriculares:" << std::endl;
+        for (const auto &entry: shared) {
+            std::cout << "  " << entry.second << " (" << ucCodeToName(entry.second) << ") - " << entry.first
+                      << " alunos" << std::endl;
+        }
+    }
+    SCHEDULE_LATENCY_STOP();
+    std::cout << "Prima Enter para continuar.";
+    std::cin.ignore();
+    std::cin.get();
+    system("clear");
+}
+
+/**
+ * @brief Permite obter o número de alunos inscritos em duas unidades curriculares.
+ * Complexidade: O(1) em média.
+ * @param ucA - Código da primeira UC.
+ * @param ucB - Código da segunda UC.
+ * @return Número de alunos inscritos nas duas (0 se alguma das UCs não existir).
+ */
+unsigned int ScheduleManager::commonStudents(const std::string &ucA, const std::string &ucB) const {
+    int a = UCSpecificClass::findUcId(ucA), b = UCSpecificClass::findUcId(ucB);
+    if (a < 0 || b < 0) return 0;
+    return _coEnrollment.common(a, b);
+}
+
+/**
+ * @brief Exporta a matriz de coinscrição para um ficheiro CSV: uma linha e uma coluna por UC com turmas, por ordem do
+ * código, e em cada célula o número de alunos inscritos nas duas UCs (na diagonal, o número de alunos da UC).
+ * Complexidade: O(U^2 + C), sendo U o número de UCs e C o número de turmas.
+ * @param file
+ * @return Verdadeiro se o ficheiro foi escrito, falso caso contrário.
+ */
+bool ScheduleManager::exportCoEnrollment(const std::string &file) const {
+    std::ofstream out(file);
+    if (!out.is_open()) return false;
+    std::vector<std::pair<std::string, uint16_t>> ucs = ucsWithClasses();
+    out << "UcCode";
+    for (const auto &uc: ucs) out << ',' << uc.first;
+    out << std::endl;
+    for (const auto &row: ucs) {
+        out << row.first;
+        for (const auto &column: ucs) out << ',' << _coEnrollment.common(row.second, column.second);
+        out << std::endl;
+    }
+    return out.good();
+}
+
 /**
  * @brief Permite normalizar as horas.
  * Complexidade: O(1).
@@ -450,6 +1026,11 @@ std::string ScheduleManager::normalizeHours(float horas) {
     int hour = static_cast<int>(horas);
     int minutes = static_cast<int>((horas - hour) * 60);
 
+    if (hour >= 0 && hour < 100 && minutes >= 0 && minutes < 100) {
+        const char text[5] = {static_cast<char>('0' + hour / 10), static_cast<char>('0' + hour % 10), ':',
+                              static_cast<char>('0' + minutes / 10), static_cast<char>('0' + minutes % 10)};
+        return {text, sizeof(text)};
+    }
     std::ostringstream formattedTime;
     formattedTime << std::setw(2) << std::setfill('0') << hour << ":" << std::setw(2) << std::setfill('0') << minutes;
 
@@ -457,56 +1038,34 @@ std::string ScheduleManager::normalizeHours(float horas) {
 }
 
 /**
- * @brief Permite mostrar as unidades curriculares por nome.
+ * @brief Permite mostrar as unidades curriculares por nome, consultando o catálogo.
  * Complexidade: O(1).
  * @param ucCode
  * @return Nome da unidadade curricular.
  */
 std::string ScheduleManager::ucCodeToName(const std::string &ucCode) {
-    std::map<std::string, std::string> ucs = {{"UP001",    "PUP"},
-                                              {"L.EIC001", "ALGA"},
-                                              {"L.EIC002", "AM I"},
-                                              {"L.EIC003", "FP"},
-                                              {"L.EIC004", "FSC"},
-                                              {"L.EIC005", "MD"},
-                                              {"L.EIC011", "AED"},
-                                              {"L.EIC012", "BD"},
-                                              {"L.EIC013", "F II"},
-                                              {"L.EIC014", "LDTS"},
-                                              {"L.EIC015", "SO"},
-                                              {"L.EIC021", "FSI"},
-                                              {"L.EIC022", "IPC"},
-                                              {"L.EIC023", "LBAW"},
-                                              {"L.EIC024", "PFL"},
-                                              {"L.EIC025", "RC"}};
-    return ucs[ucCode];
-}
-
-/**
- * @brief Organiza as unidades curriculares por ano.
- * Complexidade: O(1).
+    const UcInfo *uc = _catalog.find(ucCode);
+    return uc == nullptr ? std::string() : uc->name;
+}
+
+/**
+ * @brief Organiza as unidades curriculares por ano, segundo o catálogo.
+ * Complexidade: O(N), sendo N o número de UCs do ano.
  * @param ano
  * @return Vetor com as unidades curriculares do ano desejado.
  */
 std::vector<std::string> ScheduleManager::UcsOfAClasse(const char &ano) {
-    std::map<char, std::vector<std::string>> ucOfClass = {{'1', {"UP001",    "L.EIC001", "L.EIC002", "L.EIC003", "L.EIC004", "L.EIC005"}},
-                                                          {'2', {"L.EIC011", "L.EIC012", "L.EIC013", "L.EIC014", "L.EIC015"}},
-                                                          {'3', {"L.EIC021", "L.EIC022", "L.EIC023", "L.EIC024", "L.EIC025"}}};
-    return ucOfClass.at(ano);
+    return _catalog.ucsOfYear(ano);
 }
 
 /**
  * @brief Permite encontrar um estudante.
- * Complexidade: O(logN).
+ * Complexidade: O(1) em média.
  * @param studentCode
  * @return Objeto do tipo Student caso encontrado, nullptr caso contrário.
  */
 Student *ScheduleManager::findStudent(unsigned int studentCode) {
-    auto it = _students.find(studentCode);
-    if (it != _students.end()) {
-        return &it->second;
-    }
-    return nullptr;
+    return _students.find(studentCode);
 }
 
 /**
@@ -543,7 +1102,7 @@ bool ScheduleManager::findUc(const std::string &ucCode) {
  * @return Número de pedidos pendentes.
  */
 int ScheduleManager::getNumOfPendingRequests() const {
-    return _changeClassRequests.size() + _enrollmentRequests.size() + _removalRequests.size();
+    return _changeClassRequests.size() + _changeUcRequests.size() + _enrollmentRequests.size() + _removalRequests.size();
 }
 
 /**
@@ -551,54 +1110,59 @@ int ScheduleManager::getNumOfPendingRequests() const {
  * Complexidade: O(N).
  */
 void ScheduleManager::printPendingRequests() const {
+    SCHEDULE_LATENCY();
     system("clear");
     if (getNumOfPendingRequests() == 0) {
         std::cout << "Não existem pedidos pendentes." << std::endl;
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
         system("clear");
         return;
     }
+    OutputBuffer out = listing();
     std::queue<Requests> pendingChangeClassRequests = _changeClassRequests;
-    std::cout << "Pedidos de alteração de turma: " << pendingChangeClassRequests.size() << std::endl;
+    out << "Pedidos de alteração de turma: " << pendingChangeClassRequests.size() << '\n';
     while (!pendingChangeClassRequests.empty()) {
-        std::cout << pendingChangeClassRequests.front().getStudent().getName()
-                  << " | " << pendingChangeClassRequests.front().getStudent().getStudentCode() << std::endl;
+        out << pendingChangeClassRequests.front().getStudent().getName()
+            << " | " << pendingChangeClassRequests.front().getStudent().getStudentCode() << '\n';
         pendingChangeClassRequests.pop();
     }
 
-    std::cout << "-------------------------------------------------" << std::endl << std::endl;
+    out << "-------------------------------------------------\n\n";
 
     std::queue<std::pair<Requests, std::string>> pendingChangeUcRequests = _changeUcRequests;
-    std::cout << "Pedidos de alteração de Uc: " << pendingChangeUcRequests.size() << std::endl;
+    out << "Pedidos de alteração de Uc: " << pendingChangeUcRequests.size() << '\n';
     while (!pendingChangeUcRequests.empty()) {
-        std::cout << pendingChangeUcRequests.front().first.getStudent().getName()
-                  << " | " << pendingChangeUcRequests.front().first.getStudent().getStudentCode() << std::endl;
+        out << pendingChangeUcRequests.front().first.getStudent().getName()
+            << " | " << pendingChangeUcRequests.front().first.getStudent().getStudentCode() << '\n';
         pendingChangeUcRequests.pop();
     }
 
-    std::cout << "-------------------------------------------------" << std::endl << std::endl;
+    out << "-------------------------------------------------\n\n";
 
     std::queue<Requests> pendingEnrollmentRequests = _enrollmentRequests;
-    std::cout << "Pedidos de inscrição numa Uc: " << pendingEnrollmentRequests.size() << std::endl;
+    out << "Pedidos de inscrição numa Uc: " << pendingEnrollmentRequests.size() << '\n';
     while (!pendingEnrollmentRequests.empty()) {
-        std::cout << pendingEnrollmentRequests.front().getStudent().getName()
-                  << " | " << pendingEnrollmentRequests.front().getStudent().getStudentCode() << std::endl;
+        out << pendingEnrollmentRequests.front().getStudent().getName()
+            << " | " << pendingEnrollmentRequests.front().getStudent().getStudentCode() << '\n';
         pendingEnrollmentRequests.pop();
     }
 
-    std::cout << "-------------------------------------------------" << std::endl << std::endl;
+    out << "-------------------------------------------------\n\n";
 
     std::queue<Requests> pendingRemovalRequests = _removalRequests;
-    std::cout << "Pedidos de cancelamento de inscrição numa Uc: " << pendingRemovalRequests.size() << std::endl;
+    out << "Pedidos de cancelamento de inscrição numa Uc: " << pendingRemovalRequests.size() << '\n';
     while (!pendingRemovalRequests.empty()) {
-        std::cout << pendingRemovalRequests.front().getStudent().getName()
-                  << " | " << pendingRemovalRequests.front().getStudent().getStudentCode() << std::endl;
+        out << pendingRemovalRequests.front().getStudent().getName()
+            << " | " << pendingRemovalRequests.front().getStudent().getStudentCode() << '\n';
         pendingRemovalRequests.pop();
     }
 
-    std::cout << "-------------------------------------------------" << std::endl << std::endl;
+    out << "-------------------------------------------------\n\n";
+    out.close();
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
@@ -606,18 +1170,24 @@ void ScheduleManager::printPendingRequests() const {
 }
 
 /**
- * @brief Permite mostrar os pedidos recusados.
+ * @brief Permite mostrar os pedidos recusados, com as turmas alternativas sugeridas para cada um.
  * Complexidade: O(N).
  */
 void ScheduleManager::printRejectedRequests() {
-    system("clear");
-    std::cout << "Pedidos recusados:" << std::endl;
-    for (const auto &pair: _rejectedRequests) {
-        Requests request = pair.first;
-        std::string reason = pair.second;
-        std::cout << request.getStudent().getName() << " | " << request.getStudent().getStudentCode()
-                  << " ----- Razão: " << reason << std::endl;
+    SCHEDULE_LATENCY();
+    SCHEDULE_TRACE_SPAN("Pedidos recusados");
+    OutputBuffer out = listing();
+    out << "Pedidos recusados:\n";
+    for (const RejectedRequest &rejected: _rejectedRequests) {
+        const Student &student = rejected.request.getStudent();
+        out << student.getName() << " | " << student.getStudentCode() << " ----- Razão: " << rejected.reason;
+        if (!rejected.alternatives.empty()) {
+            out << " | Alternativas:";
+            for (uint32_t id: rejected.alternatives) out << ' ' << UCSpecificClass::fromId(id).getClassCode();
+        }
+        out << '\n';
     }
+    out.close();
     _rejectedRequests.clear();
 }
 
@@ -627,6 +1197,7 @@ void ScheduleManager::printRejectedRequests() {
  * @param student
  */
 void ScheduleManager::SubmitChangeClassRequest(Student *student) {
+    SCHEDULE_LATENCY();
     system("clear");
     std::string ucCode, classCode;
     system("clear");
@@ -634,9 +1205,12 @@ void ScheduleManager::SubmitChangeClassRequest(Student *student) {
     std::cout << student->getStudentCode() << " - " << student->getName() << std::endl;
     std::cout << "Insira o código da unidade curricular." << std::endl;
     std::cout << ">>> ";
+    SCHEDULE_LATENCY_PAUSE();
     std::cin >> ucCode;
+    SCHEDULE_LATENCY_RESUME();
     if (!findUc(ucCode)) {
         std::cout << "Unidade curricular não encontrada." << std::endl;
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
@@ -646,18 +1220,23 @@ void ScheduleManager::SubmitChangeClassRequest(Student *student) {
     if (!student->isEnrolledUc(ucCode)) {
         std::cout << "O aluno não está inscrito nesta unidade curricular."
                   << std::endl;
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
         system("clear");
         return;
     }
+    printCompatibleClasses(*student, ucCode, ucCode);
     std::cout << "Insira o código da turma desejada." << std::endl;
     std::cout << ">>> ";
+    SCHEDULE_LATENCY_PAUSE();
     std::cin >> classCode;
+    SCHEDULE_LATENCY_RESUME();
     Class *newClass = findClass(UCSpecificClass(classCode, ucCode));
     if (newClass == nullptr) {
         std::cout << "Turma não encontrada." << std::endl;
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
@@ -666,6 +1245,7 @@ void ScheduleManager::SubmitChangeClassRequest(Student *student) {
     }
     addChangeClassRequest(*student, UCSpecificClass(classCode, ucCode));
     std::cout << "Pedido submetido." << std::endl;
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
@@ -688,15 +1268,19 @@ void ScheduleManager::addChangeClassRequest(const Student &student, const UCSpec
  * @param student
  */
 void ScheduleManager::SubmitChangeUcRequest(Student *student) {
+    SCHEDULE_LATENCY();
     system("clear");
     std::string ucCodeCurrent, ucCodeDesire, classCodeDesired;
     std::cout << "--------- Trocar de unidade curricular ---------" << std::endl;
     std::cout << student->getStudentCode() << " - " << student->getName() << std::endl;
     std::cout << "Insira o código da unidade curricular que quer trocar." << std::endl;
     std::cout << ">>> ";
+    SCHEDULE_LATENCY_PAUSE();
     std::cin >> ucCodeCurrent;
+    SCHEDULE_LATENCY_RESUME();
     if (!findUc(ucCodeCurrent)) {
         std::cout << "Unidade curricular não encontrada.";
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
@@ -706,6 +1290,7 @@ void ScheduleManager::SubmitChangeUcRequest(Student *student) {
     if (!student->isEnrolledUc(ucCodeCurrent)) {
         std::cout << "O aluno não está inscrito nesta unidade curricular."
                   << std::endl;
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
@@ -714,9 +1299,12 @@ void ScheduleManager::SubmitChangeUcRequest(Student *student) {
     }
     std::cout << "Insira o código da unidade curricular para a qual deseja trocar." << std::endl;
     std::cout << ">>> ";
+    SCHEDULE_LATENCY_PAUSE();
     std::cin >> ucCodeDesire;
+    SCHEDULE_LATENCY_RESUME();
     if (!findUc(ucCodeDesire)) {
         std::cout << "Unidade curricular não encontrada.";
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
@@ -725,18 +1313,23 @@ void ScheduleManager::SubmitChangeUcRequest(Student *student) {
     }
     if (student->isEnrolledUc(ucCodeDesire)) {
         std::cout << "O aluno já está inscrito nesta unidade curricular" << std::endl;
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
         system("clear");
         return;
     }
+    printCompatibleClasses(*student, ucCodeDesire, ucCodeCurrent);
     std::cout << "Insira o código da turma desejada." << std::endl;
     std::cout << ">>> ";
+    SCHEDULE_LATENCY_PAUSE();
     std::cin >> classCodeDesired;
+    SCHEDULE_LATENCY_RESUME();
     Class *newClass = findClass(UCSpecificClass(classCodeDesired, ucCodeDesire));
     if (newClass == nullptr) {
         std::cout << "Turma não encontrada." << std::endl;
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
@@ -745,6 +1338,7 @@ void ScheduleManager::SubmitChangeUcRequest(Student *student) {
     }
     addChangeUcRequest(*student, UCSpecificClass(classCodeDesired, ucCodeDesire), ucCodeCurrent);
     std::cout << "Pedido submetido." << std::endl;
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
@@ -768,15 +1362,19 @@ void ScheduleManager::addChangeUcRequest(const Student &student, const UCSpecifi
  * @param student
  */
 void ScheduleManager::SubmitRemovalRequest(Student *student) {
+    SCHEDULE_LATENCY();
     system("clear");
     std::string ucCode;
     std::cout << "--------- Remover aluno ---------" << std::endl;
     std::cout << student->getStudentCode() << " - " << student->getName() << std::endl;
     std::cout << "Insira o código da unidade curricular." << std::endl;
     std::cout << ">>> ";
+    SCHEDULE_LATENCY_PAUSE();
     std::cin >> ucCode;
+    SCHEDULE_LATENCY_RESUME();
     if (!findUc(ucCode)) {
         std::cout << "Unidade curricular não encontrada.";
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
@@ -785,6 +1383,7 @@ void ScheduleManager::SubmitRemovalRequest(Student *student) {
     }
     if (!student->isEnrolledUc(ucCode)) {
         std::cout << "O aluno não está inscrito nesta unidade curricular." << std::endl;
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
@@ -793,6 +1392,7 @@ void ScheduleManager::SubmitRemovalRequest(Student *student) {
     }
     addRemovalRequest(*student, UCSpecificClass(student->findUCSpecificClass(ucCode).getClassCode(), ucCode));
     std::cout << "Pedido submetido." << std::endl;
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
@@ -815,15 +1415,19 @@ void ScheduleManager::addRemovalRequest(const Student &student, const UCSpecific
  * @param student
  */
 void ScheduleManager::SubmitEnrollmentRequest(Student *student) {
+    SCHEDULE_LATENCY();
     system("clear");
     std::string ucCode, classCode;
     std::cout << "--------- Inscrição em unidade curricular ---------" << std::endl;
     std::cout << student->getStudentCode() << " - " << student->getName() << std::endl;
     std::cout << "Insira o código da unidade curricular." << std::endl;
     std::cout << ">>> ";
+    SCHEDULE_LATENCY_PAUSE();
     std::cin >> ucCode;
+    SCHEDULE_LATENCY_RESUME();
     if (!findUc(ucCode)) {
         std::cout << "Unidade curricular não encontrada.";
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
@@ -832,18 +1436,23 @@ void ScheduleManager::SubmitEnrollmentRequest(Student *student) {
     }
     if (student->isEnrolledUc(ucCode)) {
         std::cout << "O aluno já está inscrito nesta unidade curricular." << std::endl;
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
         system("clear");
         return;
     }
+    printCompatibleClasses(*student, ucCode);
     std::cout << "Insira o código da turma desejada." << std::endl;
     std::cout << ">>> ";
+    SCHEDULE_LATENCY_PAUSE();
     std::cin >> classCode;
+    SCHEDULE_LATENCY_RESUME();
     Class *newClass = findClass(UCSpecificClass(classCode, ucCode));
     if (newClass == nullptr) {
         std::cout << "Turma não encontrada." << std::endl;
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
@@ -852,6 +1461,7 @@ void ScheduleManager::SubmitEnrollmentRequest(Student *student) {
     }
     addEnrollmentRequest(*student, UCSpecificClass(classCode, ucCode));
     std::cout << "Pedido submetido." << std::endl;
+    SCHEDULE_LATENCY_STOP();
     std::cout << "Prima Enter para continuar.";
     std::cin.ignore();
     std::cin.get();
@@ -868,18 +1478,132 @@ void ScheduleManager::addEnrollmentRequest(const Student &student, const UCSpeci
     _enrollmentRequests.emplace(student, ucSpecificClass, "Enrollment");
 }
 
+/**
+ * @brief Permite gerar um horário para um aluno a partir de uma lista de UCs e submeter, de uma só vez, os pedidos de
+ * inscrição nas turmas do horário escolhido.
+ * Complexidade: O(T^U) no pior caso, sendo U o número de UCs e T o número de turmas de cada UC.
+ * @param student
+ */
+void ScheduleManager::SubmitTimetableRequest(Student *student) {
+    SCHEDULE_LATENCY();
+    system("clear");
+    std::string linha, ucCode;
+    std::cout << "--------- Gerar horário ---------" << std::endl;
+    std::cout << student->getStudentCode() << " - " << student->getName() << std::endl;
+    std::cout << "Insira os códigos das unidades curriculares, separados por espaços." << std::endl;
+    std::cout << ">>> ";
+    SCHEDULE_LATENCY_PAUSE();
+    std::cin.ignore();
+    std::getline(std::cin, linha);
+    SCHEDULE_LATENCY_RESUME();
+    std::vector<std::string> ucCodes;
+    std::stringstream linhaStream(linha);
+    while (linhaStream >> ucCode) {
+        if (!findUc(ucCode)) {
+            std::cout << "Unidade curricular " << ucCode << " não encontrada." << std::endl;
+        } else if (student->isEnrolledUc(ucCode)) {
+            std::cout << "O aluno já está inscrito na unidade curricular " << ucCode << "." << std::endl;
+        } else if (std::find(ucCodes.begin(), ucCodes.end(), ucCode) == ucCodes.end()) {
+            ucCodes.push_back(ucCode);
+        }
+    }
+    std::vector<Timetable> timetables =
+            ucCodes.empty() ? std::vector<Timetable>() : generateTimetables(*student, ucCodes, 5);
+    if (timetables.empty()) {
+        std::cout << "Não existe nenhum horário sem sobreposições com vagas nestas unidades curriculares." << std::endl;
+        SCHEDULE_LATENCY_STOP();
+        std::cout << "Prima Enter para continuar.";
+        std::cin.get();
+        system("clear");
+        return;
+    }
+    for (size_t i = 0; i < timetables.size(); i++) {
+        std::cout << i + 1 << ".";
+        for (uint32_t id: timetables[i].classIds) {
+            UCSpecificClass ucClass = UCSpecificClass::fromId(id);
+            std::cout << ' ' << ucClass.getUcCode() << '/' << ucClass.getClassCode();
+        }
+        std::cout << " (desvio " << std::showpos << std::fixed << std::setprecision(3) << timetables[i].balanceCost
+                  << std::noshowpos << std::defaultfloat << ", " << timetables[i].gaps
+                  << " meias horas livres entre aulas)" << std::endl;
+    }
+    std::cout << "Escolha o horário (0 para cancelar)." << std::endl;
+    std::cout << ">>> ";
+    size_t choice = 0;
+    SCHEDULE_LATENCY_PAUSE();
+    std::cin >> choice;
+    SCHEDULE_LATENCY_RESUME();
+    if (choice >= 1 && choice <= timetables.size()) {
+        for (uint32_t id: timetables[choice - 1].classIds) addEnrollmentRequest(*student, UCSpecificClass::fromId(id));
+        std::cout << "Pedidos submetidos." << std::endl;
+    }
+    SCHEDULE_LATENCY_STOP();
+    std::cout << "Prima Enter para continuar.";
+    std::cin.ignore();
+    std::cin.get();
+    system("clear");
+}
+
+/**
+ * @brief Gera os melhores horários de um aluno com uma turma de cada uma das UCs indicadas, sem sobreposições entre
+ * si nem com as restantes UCs do aluno. Só são consideradas turmas com vagas e cuja inscrição favorece o balanceamento;
+ * os horários são ordenados pela variação do desvio padrão das turmas e pelas meias horas livres entre aulas.
+ * Complexidade: O(T^U) no pior caso, sendo U o número de UCs e T o número de turmas de cada UC.
+ * @param student - Aluno.
+ * @param ucCodes - Códigos das UCs.
+ * @param count - Número máximo de horários.
+ * @return Horários, do melhor para o pior (vazio se alguma UC não existir ou não houver nenhum horário possível).
+ */
+std::vector<Timetable> ScheduleManager::generateTimetables(const Student &student,
+                                                           const std::vector<std::string> &ucCodes,
+                                                           size_t count) const {
+    std::vector<int> ucIds;
+    for (const std::string &ucCode: ucCodes) {
+        int ucId = UCSpecificClass::findUcId(ucCode);
+        if (ucId < 0) return {};
+        ucIds.push_back(ucId);
+    }
+    std::vector<uint32_t> kept;
+    for (uint32_t id: student.getTurmaIds()) {
+        if (std::find(ucIds.begin(), ucIds.end(), UCSpecificClass::ucIdOf(id)) == ucIds.end()) kept.push_back(id);
+    }
+
+    std::vector<std::vector<TimetableOption>> options;
+    for (int ucId: ucIds) {
+        options.emplace_back();
+        for (uint32_t id: _lessonTable.compatibleClasses(ucId, kept)) {
+            if (_freeSeats.freeSeats(id) == 0) continue;
+            UCSpecificClass ucClass = UCSpecificClass::fromId(id);
+            unsigned int size = _classes.at(ucClass).getStudentsIDs().size();
+            if (!keepsBalance(ucClass, ucClass)) continue;
+            double cost = desvioAfterChange(ucClass, ucClass, size, size + 1) - desvioClasses(ucClass);
+            options.back().push_back({id, _lessonTable.busyMask({id}), _lessonTable.occupiedMask({id}), cost});
+        }
+    }
+    TimetableGenerator generator(std::move(options), _lessonTable.busyMask(kept), _lessonTable.occupiedMask(kept),
+                                 _lessonTable);
+    return generator.generate(count);
+}
+
 /**
  * @brief Processa os pedidos de cancelamento de inscrição.
  * complexidade: O(N).
  * @param request
  */
 void ScheduleManager::processRemovalRequests(const Requests &request) {
+    SCHEDULE_LATENCY();
+    SCHEDULE_TRACE_SPAN_DETAIL("processRemovalRequests", traceDetail(request));
     Student *auxStudent = findStudent(request.getStudent().getStudentCode());
     Class *auxClass = findClass(request.getDesiredClass());
-    auxStudent->removeTurma(auxClass->getUcClass().getUcCode());
-    findClass(auxClass->getUcClass())->removeStudent(auxStudent->getStudentCode());
+    if (!auxStudent->isEnrolledUc(auxClass->getUcClass().getUcCode())) {
+        reject(request, "O aluno já não está inscrito nesta unidade curricular.");
+        SCHEDULE_COUNT_REQUEST(Removal, Invalid);
+        return;
+    }
+    unenroll(*auxStudent, auxClass->getUcClass());
 
     _acceptedRequests.emplace(request.getStudent(), request.getDesiredClass(), "Enrollment");
+    SCHEDULE_COUNT_REQUEST(Removal, Accepted);
     std::cout << "O aluno " << request.getStudent().getName() << "de número UP" << request.getStudent().getStudentCode()
               << " foi removido da unidade curricular " << request.getDesiredClass().getUcCode() << std::endl;
 }
@@ -890,28 +1614,41 @@ void ScheduleManager::processRemovalRequests(const Requests &request) {
  * @param request
  */
 void ScheduleManager::processEnrollmentRequests(const Requests &request) {
+    SCHEDULE_LATENCY();
+    SCHEDULE_TRACE_SPAN_DETAIL("processEnrollmentRequests", traceDetail(request));
     Student *student = findStudent(request.getStudent().getStudentCode());
     Class *desiredClass = findClass(request.getDesiredClass());
+    if (student->isEnrolledUc(request.getDesiredClass().getUcCode())) {
+        reject(request, "O aluno já está inscrito nesta unidade curricular.");
+        SCHEDULE_COUNT_REQUEST(Enrollment, Invalid);
+        return;
+    }
     for (const auto &turma: student->getTurmas()) {
         if (overlapClasses(turma, desiredClass->getUcClass())) {
-            _rejectedRequests.emplace_back(request, "Conflitos com o hoŕario do aluno.");
+            reject(request, "Conflitos com o hoŕario do aluno.",
+                   suggestAlternatives(*student, request.getDesiredClass()));
+            SCHEDULE_COUNT_REQUEST(Enrollment, Conflict);
             return;
         }
     }
     if (exceedsCapacity(request)) {
-        _rejectedRequests.emplace_back(request, "Excede o número máximo de alunos permitidos.");
+        reject(request, "Excede o número máximo de alunos permitidos.",
+               suggestAlternatives(*student, request.getDesiredClass()));
+        SCHEDULE_COUNT_REQUEST(Enrollment, Capacity);
         return;
     } else if (!balancedClasses(request.getDesiredClass(), request.getDesiredClass())) {
-        _rejectedRequests.emplace_back(request, "Não favorece o balanceamento das turmas.");
+        reject(request, "Não favorece o balanceamento das turmas.",
+               suggestAlternatives(*student, request.getDesiredClass()));
+        SCHEDULE_COUNT_REQUEST(Enrollment, Balance);
         return;
     } else {
-        student->addTurma(request.getDesiredClass());
-        findClass(request.getDesiredClass())->addStudent(request.getStudent().getStudentCode());
+        enroll(*student, desiredClass->getUcClass());
         std::cout << "O aluno " << request.getStudent().getName() << "de número UP"
                   << request.getStudent().getStudentCode()
                   << " foi inscrito na unidade curricular " << request.getDesiredClass().getUcCode() << std::endl;
 
         _acceptedRequests.emplace(request.getStudent(), request.getDesiredClass(), "Removal");
+        SCHEDULE_COUNT_REQUEST(Enrollment, Accepted);
     }
 }
 
@@ -921,39 +1658,49 @@ void ScheduleManager::processEnrollmentRequests(const Requests &request) {
  * @param request
  */
 void ScheduleManager::processChangeClassRequests(const Requests &request) {
+    SCHEDULE_LATENCY();
+    SCHEDULE_TRACE_SPAN_DETAIL("processChangeClassRequests", traceDetail(request));
     Student *student = findStudent(request.getStudent().getStudentCode());
     Class *desiredClass = findClass(request.getDesiredClass());
+    std::string ucCode = request.getDesiredClass().getUcCode();
+    if (!student->isEnrolledUc(ucCode)) {
+        reject(request, "O aluno já não está inscrito nesta unidade curricular.");
+        SCHEDULE_COUNT_REQUEST(ChangeClass, Invalid);
+        return;
+    }
+    UCSpecificClass currentClass = student->findUCSpecificClass(ucCode);
     if (exceedsCapacity(request)) {
-        _rejectedRequests.emplace_back(request, "Excede o número máximo de alunos permitidos.");
+        reject(request, "Excede o número máximo de alunos permitidos.",
+               suggestAlternatives(*student, request.getDesiredClass(), ucCode));
+        SCHEDULE_COUNT_REQUEST(ChangeClass, Capacity);
         return;
     }
 
-    if (!balancedClasses(student->findUCSpecificClass(request.getDesiredClass().getUcCode()),
-                         request.getDesiredClass())) {
-        _rejectedRequests.emplace_back(request, "Não favorece o balanceamento das turmas.");
+    if (!balancedClasses(currentClass, request.getDesiredClass())) {
+        reject(request, "Não favorece o balanceamento das turmas.",
+               suggestAlternatives(*student, request.getDesiredClass(), ucCode));
+        SCHEDULE_COUNT_REQUEST(ChangeClass, Balance);
         return;
     }
 
     for (const auto &turma: student->getTurmas()) {
-        if (overlapClasses(turma, desiredClass->getUcClass())) {
-            _rejectedRequests.emplace_back(request, "Conflitos com o hoŕario do aluno.");
+        if (turma.getUcCode() != ucCode && overlapClasses(turma, desiredClass->getUcClass())) {
+            reject(request, "Conflitos com o hoŕario do aluno.",
+                   suggestAlternatives(*student, request.getDesiredClass(), ucCode));
+            SCHEDULE_COUNT_REQUEST(ChangeClass, Conflict);
             return;
         }
     }
 
     std::cout << "O aluno " << request.getStudent().getName() << " com número UP "
               << request.getStudent().getStudentCode() << " na UC "
-              << request.getDesiredClass().getUcCode() << " foi movido da turma "
-              << student->findUCSpecificClass(request.getDesiredClass().getUcCode()).getClassCode()
-              << " para a turma " << request.getDesiredClass().getClassCode();
-    student->changeTurma(request.getDesiredClass());
-    findClass(student->findUCSpecificClass(request.getDesiredClass().getUcCode()))->removeStudent(
-            student->getStudentCode());
-    desiredClass->addStudent(student->getStudentCode());
+              << ucCode << " foi movido da turma "
+              << currentClass.getClassCode()
+              << " para a turma " << request.getDesiredClass().getClassCode() << std::endl;
+    switchClass(*student, desiredClass->getUcClass());
 
-    _acceptedRequests.emplace(request.getStudent(),
-                              request.getStudent().findUCSpecificClass(request.getDesiredClass().getUcCode()),
-                              "SwitchClass");
+    _acceptedRequests.emplace(request.getStudent(), currentClass, "SwitchClass");
+    SCHEDULE_COUNT_REQUEST(ChangeClass, Accepted);
 }
 
 /**
@@ -963,19 +1710,37 @@ void ScheduleManager::processChangeClassRequests(const Requests &request) {
  * @param ucCurrent
  */
 void ScheduleManager::processChangeUcRequests(const Requests &request, const std::string &ucCurrent) {
+    SCHEDULE_LATENCY();
+    SCHEDULE_TRACE_SPAN_DETAIL("processChangeUcRequests", traceDetail(request));
     Student *student = findStudent(request.getStudent().getStudentCode());
     Class *desiredClass = findClass(request.getDesiredClass());
+    if (!student->isEnrolledUc(ucCurrent)) {
+        reject(request, "O aluno já não está inscrito nesta unidade curricular.");
+        SCHEDULE_COUNT_REQUEST(ChangeUc, Invalid);
+        return;
+    } else if (student->isEnrolledUc(request.getDesiredClass().getUcCode())) {
+        reject(request, "O aluno já está inscrito nesta unidade curricular.");
+        SCHEDULE_COUNT_REQUEST(ChangeUc, Invalid);
+        return;
+    }
+    UCSpecificClass currentClass = student->findUCSpecificClass(ucCurrent);
     if (exceedsCapacity(request)) {
-        _rejectedRequests.emplace_back(request, "Excede a capacidade máxima.");
+        reject(request, "Excede a capacidade máxima.",
+               suggestAlternatives(*student, request.getDesiredClass(), ucCurrent));
+        SCHEDULE_COUNT_REQUEST(ChangeUc, Capacity);
         return;
     } else if (!balancedClasses(request.getDesiredClass(), request.getDesiredClass())) {
-        _rejectedRequests.emplace_back(request, "Não favorece o balanceamento das turmas.");
+        reject(request, "Não favorece o balanceamento das turmas.",
+               suggestAlternatives(*student, request.getDesiredClass(), ucCurrent));
+        SCHEDULE_COUNT_REQUEST(ChangeUc, Balance);
         return;
     }
 
     for (const auto &turma: student->getTurmas()) {
-        if (overlapClasses(turma, desiredClass->getUcClass())) {
-            _rejectedRequests.emplace_back(request, "Conflitos com o hoŕario do aluno.");
+        if (turma.getUcCode() != ucCurrent && overlapClasses(turma, desiredClass->getUcClass())) {
+            reject(request, "Conflitos com o hoŕario do aluno.",
+                   suggestAlternatives(*student, request.getDesiredClass(), ucCurrent));
+            SCHEDULE_COUNT_REQUEST(ChangeUc, Conflict);
             return;
         }
     }
@@ -984,33 +1749,28 @@ void ScheduleManager::processChangeUcRequests(const Requests &request, const std
               << request.getStudent().getStudentCode() << " mudou da Uc "
               << ucCurrent << " para a Uc "
               << request.getDesiredClass().getUcCode() << " para a turma "
-              << request.getDesiredClass().getClassCode();
-    student->removeTurma(ucCurrent);
-    student->addTurma(UCSpecificClass(request.getDesiredClass()));
-    findClass(UCSpecificClass(ucCurrent, request.getDesiredClass().getUcCode()))->removeStudent(
-            student->getStudentCode());
-    desiredClass->addStudent(student->getStudentCode());
-
-    //add to acceptedRequests stack the inverse request
-    _acceptedRequests.emplace(request.getStudent(), request.getStudent().findUCSpecificClass(ucCurrent),
-                              "SwitchUC");
+              << request.getDesiredClass().getClassCode() << std::endl;
+    //add to acceptedRequests stack the inverse request, with the student as it is before the change
+    _acceptedRequests.emplace(*student, currentClass, "SwitchUC");
+    unenroll(*student, currentClass);
+    enroll(*student, desiredClass->getUcClass());
+    SCHEDULE_COUNT_REQUEST(ChangeUc, Accepted);
 
 }
 
 /**
  * @brief Processa todos os pedidos, dando print dos pedidos aceites e recusados.
- * @see processRemovalRequests().
- * @see processEnrollmentRequests().
- * @see processChangeClassRequests().
- * @see processChangeUcRequests().
+ * @see processPendingRequests().
  * @see printRejectedRequests().
  * @see UpdateStudentsClassesCSV().
  */
 void ScheduleManager::processRequests() {
+    SCHEDULE_LATENCY();
     system("clear");
 
     if (_removalRequests.empty() && _changeUcRequests.empty() && _enrollmentRequests.empty() && _changeClassRequests.empty()) {
         std::cout << "Nada para ser processado." << std::endl;
+        SCHEDULE_LATENCY_STOP();
         std::cout << "Prima Enter para continuar.";
         std::cin.ignore();
         std::cin.get();
@@ -1018,71 +1778,304 @@ void ScheduleManager::processRequests() {
         return;
     }
 
+    SCHEDULE_RESET_SUMMARY();
+    processPendingRequests();
+
+    if (!_rejectedRequests.empty()) {
+        system("clear");
+        printRejectedRequests();
+    } else {
+        std::cout << "Todos os pedidos foram aceites." << std::endl;
+    }
+    std::cout << "-------------------------------------------------" << std::endl << std::endl;
+
+    UpdateStudentsClassesCSV();
+    SCHEDULE_PRINT_SUMMARY(std::cout);
+
+    SCHEDULE_LATENCY_STOP();
+    std::cout << "Prima Enter para continuar.";
+    std::cin.ignore();
+    std::cin.get();
+    system("clear");
+}
+
+/**
+ * @brief Processa, por fases, todos os pedidos pendentes, dando print dos pedidos aceites.
+ * Os pedidos recusados ficam guardados até serem mostrados.
+ * @see processRemovalRequests().
+ * @see processEnrollmentRequests().
+ * @see processChangeClassRequests().
+ * @see processChangeUcRequests().
+ */
+void ScheduleManager::processPendingRequests() {
+    SCHEDULE_LATENCY();
+    SCHEDULE_TRACE_SPAN("processPendingRequests");
     std::cout << "Pedidos de cancelamento de inscrição aceites:" << std::endl;
 
-    while (!_removalRequests.empty()) {
-        processRemovalRequests(_removalRequests.front());
-        _removalRequests.pop();
+    {
+        SCHEDULE_TRACE_SPAN("Cancelamentos");
+        while (!_removalRequests.empty()) {
+            processRemovalRequests(_removalRequests.front());
+            _removalRequests.pop();
+        }
     }
 
     std::cout << "-------------------------------------------------" << std::endl << std::endl;
 
     std::cout << "Pedidos de inscrição aceites:" << std::endl;
 
-    while (!_enrollmentRequests.empty()) {
-        processEnrollmentRequests(_enrollmentRequests.front());
-        _enrollmentRequests.pop();
+    {
+        SCHEDULE_TRACE_SPAN("Inscrições");
+        while (!_enrollmentRequests.empty()) {
+            processEnrollmentRequests(_enrollmentRequests.front());
+            _enrollmentRequests.pop();
+        }
     }
 
     std::cout << "-------------------------------------------------" << std::endl << std::endl;
 
     std::cout << "Pedidos de alteração de turma aceites:" << std::endl;
-    while (!_changeClassRequests.empty()) {
-        processChangeClassRequests(_changeClassRequests.front());
-        _changeClassRequests.pop();
+    {
+        SCHEDULE_TRACE_SPAN("Alterações de turma");
+        while (!_changeClassRequests.empty()) {
+            processChangeClassRequests(_changeClassRequests.front());
+            _changeClassRequests.pop();
+        }
     }
 
     std::cout << "-------------------------------------------------" << std::endl << std::endl;
 
     std::cout << "Pedidos de alteração de Uc aceites:" << std::endl;
-    while (!_changeUcRequests.empty()) {
-        processChangeUcRequests(_changeUcRequests.front().first, _changeUcRequests.front().second);
-        _changeUcRequests.pop();
+    {
+        SCHEDULE_TRACE_SPAN("Alterações de UC");
+        while (!_changeUcRequests.empty()) {
+            processChangeUcRequests(_changeUcRequests.front().first, _changeUcRequests.front().second);
+            _changeUcRequests.pop();
+        }
     }
 
     std::cout << "-------------------------------------------------" << std::endl << std::endl;
+}
 
-    if (!_rejectedRequests.empty()) {
-        printRejectedRequests();
-    } else {
-        std::cout << "Todos os pedidos foram aceites." << std::endl;
-    }
-    std::cout << "-------------------------------------------------" << std::endl << std::endl;
-    std::cout << "Prima Enter para continuar.";
-    std::cin.ignore();
-    std::cin.get();
-    system("clear");
+/**
+ * @brief Equilibra as turmas das UCs cujo desvio padrão ficou acima de BALANCE_THRESHOLD (por exemplo, depois de
+ * processar um lote de pedidos), com o menor número de mudanças de turma possível.
+ * As mudanças de cada UC são calculadas por um fluxo de custo mínimo (ClassRebalancer) sobre as turmas da UC, só para
+ * turmas que não se sobrepõem ao resto do horário de cada aluno. O plano de cada UC é aplicado como uma transação:
+ * primeiro é verificado por inteiro (capacidade das turmas e sobreposições) e só depois são feitas todas as mudanças,
+ * ou nenhuma. Cada mudança fica na pilha dos pedidos aceites, para poder ser anulada.
+ * Complexidade: O(U * (N * T log C + F * V * E)), sendo U o número de UCs desequilibradas, N o número de alunos da UC,
+ * T o número de turmas da UC, C o número de turmas, F o número de mudanças, V o número de turmas e alunos da UC e E o
+ * número de mudanças possíveis.
+ * @return Número de alunos mudados de turma.
+ */
+unsigned int ScheduleManager::rebalanceClasses() {
+    SCHEDULE_LATENCY();
+    SCHEDULE_TRACE_SPAN("rebalanceClasses");
+    unsigned int moved = 0, ucs = 0;
+    std::ios_base::fmtflags flags = std::cout.flags();
+    std::streamsize precision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Rebalanceamento das turmas:" << std::endl;
+    for (uint16_t ucId = 0; ucId < _ucBalance.size(); ucId++) {
+        double before = desvio(_ucBalance[ucId]);
+        if (before <= BALANCE_THRESHOLD) continue;
+        std::vector<uint32_t> classIds = _lessonTable.compatibleClasses(ucId, {});
+        if (classIds.empty()) continue;
+        std::string ucCode = UCSpecificClass::fromId(classIds[0]).getUcCode();
+
+        std::vector<RebalanceClass> classes;
+        for (uint32_t id: classIds) {
+            UCSpecificClass ucClass = UCSpecificClass::fromId(id);
+            classes.push_back({id, static_cast<unsigned int>(_classes.at(ucClass).getStudentsIDs().size()),
+                               maxCapacity(ucClass)});
+        }
+        ClassRebalancer rebalancer(classes, BALANCE_THRESHOLD);
+        std::vector<unsigned int> codes;
+        for (uint32_t c = 0; c < classIds.size(); c++) {
+            for (unsigned int code: _classes.at(UCSpecificClass::fromId(classIds[c])).getStudentsIDs()) {
+                std::vector<uint32_t> others, allowed;
+                for (uint32_t id: _students.at(code).getTurmaIds()) {
+                    if (UCSpecificClass::ucIdOf(id) != ucId) others.push_back(id);
+                }
+                for (uint32_t id: _lessonTable.compatibleClasses(ucId, others)) {
+                    allowed.push_back(std::lower_bound(classIds.begin(), classIds.end(), id) - classIds.begin());
+                }
+                rebalancer.addStudent(c, std::move(allowed));
+                codes.push_back(code);
+            }
+        }
+        std::vector<RebalanceMove> moves = rebalancer.plan();
+        if (moves.empty()) {
+            std::cout << "UC " << ucCode << ": não é possível diminuir o desvio padrão (" << before << ")."
+                      << std::endl;
+            continue;
+        }
 
-    UpdateStudentsClassesCSV();
+        std::vector<unsigned int> sizes;
+        for (const RebalanceClass &info: classes) sizes.push_back(info.size);
+        bool valid = true;
+        for (const RebalanceMove &move: moves) {
+            sizes[move.from]--;
+            sizes[move.to]++;
+            for (uint32_t id: _students.at(codes[move.student]).getTurmaIds()) {
+                if (UCSpecificClass::ucIdOf(id) != ucId && _lessonTable.conflicts(id, classIds[move.to])) valid = false;
+            }
+        }
+        for (size_t c = 0; c < classes.size(); c++) {
+            if (sizes[c] > classes[c].size && sizes[c] > classes[c].capacity) valid = false;
+        }
+        if (!valid) {
+            std::cout << "UC " << ucCode << ": plano de rebalanceamento inválido, nenhuma mudança feita." << std::endl;
+            continue;
+        }
+
+        for (const RebalanceMove &move: moves) {
+            Student &student = _students.at(codes[move.student]);
+            Student previous = student;
+            UCSpecificClass oldClass = switchClass(student, UCSpecificClass::fromId(classIds[move.to]));
+            _acceptedRequests.emplace(previous, oldClass, "SwitchClass");
+            std::cout << "O aluno " << student.getName() << " com número UP " << student.getStudentCode()
+                      << " na UC " << ucCode << " foi movido da turma " << oldClass.getClassCode()
+                      << " para a turma " << UCSpecificClass::fromId(classIds[move.to]).getClassCode() << std::endl;
+        }
+        std::cout << "UC " << ucCode << ": " << moves.size() << " mudanças, desvio padrão " << before << " -> "
+                  << desvio(_ucBalance[ucId]) << "." << std::endl;
+        moved += moves.size();
+        ucs++;
+    }
+    std::cout << "Rebalanceamento: " << moved << " alunos mudados de turma em " << ucs << " UCs." << std::endl;
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+    return moved;
 }
 
 /**
- * @brief Verifica se duas turmas têm horários sobrepostos.
- * Complexidade: O(N^2).
+ * @brief Verifica se duas turmas têm horários sobrepostos, comparando as máscaras da semana das duas turmas.
+ * Complexidade: O(log C), sendo C o número de turmas.
  * @param ucSpecificClass
  * @param ucSpecificClassDesired
- * @return Verdadeiro caso não haja sobreposição, falso caso contrário.
+ * @return Verdadeiro caso haja sobreposição, falso caso contrário.
  */
 bool ScheduleManager::overlapClasses(const UCSpecificClass &ucSpecificClass, const UCSpecificClass &ucSpecificClassDesired) {
-    std::vector<Lesson> lessons1 = _classes.at(ucSpecificClass).getLessons();
-    std::vector<Lesson> lessons2 = _classes.at(ucSpecificClassDesired).getLessons();
-    for (const auto &l1: lessons1) {
-        for (const auto &l2: lessons2) {
-            if (l1.isOverlapping(l2))
-                return false;
-        }
+    SCHEDULE_TIME_PHASE(OverlapCheck);
+    int64_t id = ucSpecificClass.findId(), desiredId = ucSpecificClassDesired.findId();
+    return id >= 0 && desiredId >= 0 && _lessonTable.conflicts(id, desiredId);
+}
+
+/**
+ * @brief Permite obter as turmas de uma UC que não se sobrepõem ao horário atual de um aluno.
+ * Complexidade: O(K log C + U), sendo K o número de turmas do aluno e U o número de turmas da UC.
+ * @param student - Aluno.
+ * @param ucCode - Código da UC.
+ * @param ignoredUc - UC do aluno cujas aulas não contam (a UC que vai deixar ou cuja turma vai trocar).
+ * @return Turmas compatíveis, pela ordem dos identificadores compactos.
+ */
+std::vector<UCSpecificClass> ScheduleManager::compatibleClasses(const Student &student, const std::string &ucCode,
+                                                                const std::string &ignoredUc) const {
+    std::vector<UCSpecificClass> classes;
+    for (uint32_t id: compatibleClassIds(student, ucCode, ignoredUc)) classes.push_back(UCSpecificClass::fromId(id));
+    return classes;
+}
+
+/**
+ * @brief Permite obter os identificadores compactos das turmas de uma UC que não se sobrepõem ao horário atual de um
+ * aluno.
+ * Complexidade: O(K log C + U), sendo K o número de turmas do aluno e U o número de turmas da UC.
+ * @param student - Aluno.
+ * @param ucCode - Código da UC.
+ * @param ignoredUc - UC do aluno cujas aulas não contam (vazio se todas contam).
+ * @return Identificadores das turmas compatíveis, por ordem crescente.
+ */
+std::vector<uint32_t> ScheduleManager::compatibleClassIds(const Student &student, const std::string &ucCode,
+                                                          const std::string &ignoredUc) const {
+    int ucId = UCSpecificClass::findUcId(ucCode);
+    if (ucId < 0) return {};
+    int ignoredUcId = ignoredUc.empty() ? -1 : UCSpecificClass::findUcId(ignoredUc);
+    std::vector<uint32_t> busy;
+    for (uint32_t id: student.getTurmaIds()) {
+        if (UCSpecificClass::ucIdOf(id) != ignoredUcId) busy.push_back(id);
+    }
+    return _lessonTable.compatibleClasses(ucId, busy);
+}
+
+/**
+ * @brief Calcula as turmas da mesma UC que o aluno podia pedir em vez de uma turma recusada: sem sobreposições com o
+ * horário do aluno (pelas máscaras da tabela de aulas), com vagas e que favorecem o balanceamento (pelos agregados
+ * de cada UC). As turmas são ordenadas da menos para a mais ocupada.
+ * Se o aluno já estiver inscrito na UC, trata-se de uma troca de turma; caso contrário, de uma inscrição.
+ * Complexidade: O(K log C + U log C), sendo K o número de turmas do aluno e U o número de turmas da UC.
+ * @param student - Aluno.
+ * @param rejectedClass - Turma recusada.
+ * @param ignoredUc - UC do aluno cujas aulas não contam (a UC da troca, ou a UC que o aluno vai deixar).
+ * @return Identificadores compactos das turmas alternativas.
+ */
+std::vector<uint32_t> ScheduleManager::suggestAlternatives(const Student &student, const UCSpecificClass &rejectedClass,
+                                                           const std::string &ignoredUc) const {
+    SCHEDULE_TIME_PHASE(Suggestions);
+    const std::string &ucCode = rejectedClass.getUcCode();
+    bool enrolled = student.isEnrolledUc(ucCode);
+    UCSpecificClass currentClass = enrolled ? student.findUCSpecificClass(ucCode) : rejectedClass;
+    int64_t rejectedId = rejectedClass.findId(), currentId = currentClass.findId();
+    if (classWithFreeSeats(ucCode) < 0) return {};
+
+    std::vector<std::pair<unsigned int, uint32_t>> ranked;
+    for (uint32_t id: compatibleClassIds(student, ucCode, ignoredUc)) {
+        if (id == rejectedId || id == currentId) continue;
+        if (_freeSeats.freeSeats(id) == 0) continue;
+        UCSpecificClass candidate = UCSpecificClass::fromId(id);
+        unsigned int size = _classes.at(candidate).getStudentsIDs().size();
+        if (!keepsBalance(enrolled ? currentClass : candidate, candidate)) continue;
+        ranked.emplace_back(size, id);
+    }
+    std::sort(ranked.begin(), ranked.end());
+
+    std::vector<uint32_t> alternatives;
+    alternatives.reserve(ranked.size());
+    for (const auto &pair: ranked) alternatives.push_back(pair.second);
+    return alternatives;
+}
+
+/**
+ * @brief Regista um pedido recusado.
+ * Complexidade: O(1).
+ * @param request - Pedido.
+ * @param reason - Razão da recusa.
+ * @param alternatives - Turmas alternativas sugeridas.
+ */
+void ScheduleManager::reject(const Requests &request, const std::string &reason, std::vector<uint32_t> alternatives) {
+    _rejectedRequests.push_back({request, reason, std::move(alternatives)});
+}
+
+/**
+ * @brief Permite obter os pedidos recusados que ainda não foram mostrados.
+ * Complexidade: O(1).
+ * @return Pedidos recusados, com as razões e as turmas alternativas.
+ */
+const std::vector<RejectedRequest> &ScheduleManager::getRejectedRequests() const {
+    return _rejectedRequests;
+}
+
+/**
+ * @brief Mostra as turmas de uma UC que não se sobrepõem ao horário atual de um aluno e, entre elas, a que tem mais
+ * lugares livres.
+ * Complexidade: O(U * K log C), sendo K o número de turmas do aluno e U o número de turmas da UC.
+ * @param student - Aluno.
+ * @param ucCode - Código da UC.
+ * @param ignoredUc - UC do aluno cujas aulas não contam.
+ */
+void ScheduleManager::printCompatibleClasses(const Student &student, const std::string &ucCode,
+                                             const std::string &ignoredUc) const {
+    std::vector<UCSpecificClass> classes = compatibleClasses(student, ucCode, ignoredUc);
+    std::cout << "Turmas sem sobreposição com o horário do aluno:";
+    if (classes.empty()) std::cout << " nenhuma";
+    for (const UCSpecificClass &ucClass: classes) std::cout << ' ' << ucClass.getClassCode();
+    std::cout << std::endl;
+    int64_t best = bestClassFor(student, ucCode, ignoredUc);
+    if (best >= 0) {
+        std::cout << "Turma compatível com mais lugares livres: " << UCSpecificClass::fromId(best).getClassCode()
+                  << " (" << _freeSeats.freeSeats(best) << " lugares)" << std::endl;
     }
-    return true;
 }
 
 /**
@@ -1092,46 +2085,92 @@ bool ScheduleManager::overlapClasses(const UCSpecificClass &ucSpecificClass, con
  * @return Verdadeiro caso não exceda, falso caso contrário.
  */
 bool ScheduleManager::exceedsCapacity(const Requests &request) {
-    if (_classes.at(request.getDesiredClass()).getStudentsIDs().size() >= maxCapacity(request.getDesiredClass()))
-        return true;
-    return false;
+    SCHEDULE_TIME_PHASE(CapacityCheck);
+    int64_t id = request.getDesiredClass().findId();
+    return id < 0 || _freeSeats.freeSeats(id) == 0;
 }
 
 /**
- * @brief Permite obter a capacidade máxima permitida.
- * Complexidade: O(1).
+ * @brief Permite obter a capacidade máxima de uma turma.
+ * Complexidade: O(log C), sendo C o número de turmas.
  * @param ucSpecificClass
  * @return Capacidade máxima permitida.
  */
-unsigned int ScheduleManager::maxCapacity(const UCSpecificClass &ucSpecificClass) {
-    return 30;
+unsigned int ScheduleManager::maxCapacity(const UCSpecificClass &ucSpecificClass) const {
+    return _classes.at(ucSpecificClass).getCapacity();
+}
+
+/**
+ * @brief Permite obter a turma de uma UC com mais lugares livres.
+ * Complexidade: O(1).
+ * @param ucCode - Código da UC.
+ * @return Identificador compacto da turma, ou -1 se a UC não existir ou todas as turmas estiverem cheias.
+ */
+int64_t ScheduleManager::classWithFreeSeats(const std::string &ucCode) const {
+    int ucId = UCSpecificClass::findUcId(ucCode);
+    return ucId < 0 ? -1 : _freeSeats.mostFree(ucId);
+}
+
+/**
+ * @brief Permite obter a turma de uma UC com mais lugares livres que não se sobrepõe ao horário de um aluno.
+ * As turmas são testadas por ordem decrescente de lugares livres, pelo que normalmente só a primeira é testada.
+ * Complexidade: O(M * K log C), sendo M o número de turmas testadas e K o número de turmas do aluno.
+ * @param student - Aluno.
+ * @param ucCode - Código da UC.
+ * @param ignoredUc - UC do aluno cujas aulas não contam (a UC que vai deixar ou cuja turma vai trocar).
+ * @return Identificador compacto da turma, ou -1 se nenhuma turma com lugares livres for compatível.
+ */
+int64_t ScheduleManager::bestClassFor(const Student &student, const std::string &ucCode,
+                                      const std::string &ignoredUc) const {
+    int ucId = UCSpecificClass::findUcId(ucCode), ignoredId = UCSpecificClass::findUcId(ignoredUc);
+    if (ucId < 0) return -1;
+    std::vector<uint32_t> busy;
+    for (uint32_t id: student.getTurmaIds()) {
+        if (UCSpecificClass::ucIdOf(id) != ucId && UCSpecificClass::ucIdOf(id) != ignoredId) busy.push_back(id);
+    }
+    return _freeSeats.mostFree(ucId, [&](uint32_t classId) {
+        for (uint32_t id: busy) {
+            if (_lessonTable.conflicts(id, classId)) return false;
+        }
+        return true;
+    });
 }
 
 /**
  * @brief Verifica se uma turma favorece o balanceamento das turmas.
- * Complexidade: O(N).
+ * Quando as duas turmas são a mesma, trata-se de uma inscrição (a turma ganha um aluno).
+ * Complexidade: O(log C), sendo C o número de turmas.
  * @param ucSpecificClass
  * @param ucSpecificClassDesired
  * @return Verdadeiro caso favoreça, falso caso contrário.
  */
 bool ScheduleManager::balancedClasses(const UCSpecificClass &ucSpecificClass,
                                       const UCSpecificClass &ucSpecificClassDesired) {
+    SCHEDULE_TIME_PHASE(BalanceCheck);
+    return keepsBalance(ucSpecificClass, ucSpecificClassDesired);
+}
 
-    if (desvioClasses(ucSpecificClass) < 4 && desvioAfterChange(ucSpecificClass, ucSpecificClassDesired,
-                                                                _classes.at(ucSpecificClass).getStudentsIDs().size() -
-                                                                1, _classes.at(
-                    ucSpecificClassDesired).getStudentsIDs().size() + 1) > 4) {
+/**
+ * @brief Verifica se passar um aluno de uma turma para outra (ou inscrevê-lo numa turma, se forem a mesma) favorece o
+ * balanceamento das turmas. É a regra de balancedClasses, sem contar para a instrumentação.
+ * Complexidade: O(log C), sendo C o número de turmas.
+ * @param ucSpecificClass
+ * @param ucSpecificClassDesired
+ * @return Verdadeiro caso favoreça, falso caso contrário.
+ */
+bool ScheduleManager::keepsBalance(const UCSpecificClass &ucSpecificClass,
+                                   const UCSpecificClass &ucSpecificClassDesired) const {
+    unsigned int sizeClass = _classes.at(ucSpecificClass).getStudentsIDs().size();
+    unsigned int sizeClassDesired = _classes.at(ucSpecificClassDesired).getStudentsIDs().size();
+    if (ucSpecificClass != ucSpecificClassDesired) sizeClass--;
+    double desvioAntes = desvioClasses(ucSpecificClass);
+    double desvioDepois = desvioAfterChange(ucSpecificClass, ucSpecificClassDesired, sizeClass, sizeClassDesired + 1);
+
+    if (desvioAntes < BALANCE_THRESHOLD && desvioDepois > BALANCE_THRESHOLD) {
         return false;
-    } else if (desvioClasses(ucSpecificClass) < 4 && desvioAfterChange(ucSpecificClass, ucSpecificClassDesired,
-                                                                       _classes.at(
-                                                                               ucSpecificClass).getStudentsIDs().size() -
-                                                                       1, _classes.at(
-                    ucSpecificClassDesired).getStudentsIDs().size() + 1) < 4) {
+    } else if (desvioAntes < BALANCE_THRESHOLD && desvioDepois < BALANCE_THRESHOLD) {
         return true;
-    } else if (desvioClasses(ucSpecificClass) > desvioAfterChange(ucSpecificClass, ucSpecificClassDesired,
-                                                                  _classes.at(ucSpecificClass).getStudentsIDs().size() -
-                                                                  1, _classes.at(
-                    ucSpecificClassDesired).getStudentsIDs().size() + 1)) {
+    } else if (desvioAntes > desvioDepois) {
         return true;
     } else {
         return false;
@@ -1139,68 +2178,53 @@ bool ScheduleManager::balancedClasses(const UCSpecificClass &ucSpecificClass,
 }
 
 /**
- * @brief Calcula o desvio padrão das turmas.
- * Complexidade: O(N).
+ * @brief Calcula o desvio padrão do número de alunos das turmas de uma UC a partir dos seus agregados.
+ * O numerador (n * soma dos quadrados - soma^2) é calculado em inteiros, pelo que duas distribuições com o mesmo
+ * desvio dão exatamente o mesmo resultado.
+ * Complexidade: O(1).
+ * @param balance - Agregados da UC.
+ * @return Desvio padrão.
+ */
+double ScheduleManager::desvio(const UcBalance &balance) {
+    if (balance.classes == 0) return 0;
+    return std::sqrt((double) (balance.classes * balance.sumSquares - balance.sum * balance.sum)) /
+           (double) balance.classes;
+}
+
+/**
+ * @brief Calcula o desvio padrão do número de alunos das turmas da unidade curricular.
+ * Complexidade: O(1).
  * @param ucSpecificClass
- * @return Desvio padrão das turmas.
+ * @return Desvio padrão.
  */
-double ScheduleManager::desvioClasses(const UCSpecificClass &ucSpecificClass) {
-    double media = 0, i = 0;
-    for (const auto &classes: _classes) {
-        if (classes.first == ucSpecificClass) {
-            media += (double) _classes.at(ucSpecificClass).getStudentsIDs().size();
-        } else if (classes.first.getUcCode() == ucSpecificClass.getUcCode()) {
-            media += (double) classes.second.getStudentsIDs().size();
-        }
-        i++;
-    }
-    media /= i;
-    double desvio = 0;
-    for (const auto &classes: _classes) {
-        if (classes.first.getUcCode() == ucSpecificClass.getUcCode()) {
-            desvio += std::pow((double) classes.second.getStudentsIDs().size() - media, 2);
-        }
-    }
-    return std::sqrt(desvio / i);
+double ScheduleManager::desvioClasses(const UCSpecificClass &ucSpecificClass) const {
+    int ucId = UCSpecificClass::findUcId(ucSpecificClass.getUcCode());
+    return ucId >= 0 && size_t(ucId) < _ucBalance.size() ? desvio(_ucBalance[ucId]) : 0;
 }
 
 /**
  * @brief Calcula o desvio padrão das turmas após uma alteração.
- * Complexidade: O(N).
+ * Complexidade: O(log C), sendo C o número de turmas.
  * @param ucSpecificClass
  * @param ucSpecificClassDesired
  * @param sizeClass
  * @param sizeClassDesired
- * @return Desvio padrão das turmas após uma alteração.
+ * @return Desvio padrão.
  */
 double ScheduleManager::desvioAfterChange(const UCSpecificClass &ucSpecificClass,
                                           const UCSpecificClass &ucSpecificClassDesired, const unsigned int &sizeClass,
-                                          const unsigned int &sizeClassDesired) {
-    double media = 0, i = 0;
-    for (const auto &classes: _classes) {
-        if (classes.first == ucSpecificClass) {
-            media += (double) sizeClass;
-            i++;
-        } else if (classes.first == ucSpecificClassDesired) {
-            media += (double) sizeClassDesired;
-            i++;
-        } else if (classes.first.getUcCode() == ucSpecificClass.getUcCode()) {
-            media += (double) classes.second.getStudentsIDs().size();
-            i++;
-        } else continue;
-    }
-    media /= i;
-    double desvio = 0;
-    for (const auto &classes: _classes) {
-        if (classes.first == ucSpecificClass) {
-            desvio += std::pow((double) sizeClass - media, 2);
-        } else if (classes.first == ucSpecificClassDesired) {
-            desvio += std::pow((double) sizeClassDesired - media, 2);
-        } else if (classes.first.getUcCode() == ucSpecificClass.getUcCode()) {
-            desvio += std::pow((double) _classes.at(ucSpecificClass).getStudentsIDs().size(), 2);
-        } else continue;
-    }
-    return std::sqrt(desvio / i);
+                                          const unsigned int &sizeClassDesired) const {
+    int ucId = UCSpecificClass::findUcId(ucSpecificClass.getUcCode());
+    if (ucId < 0 || size_t(ucId) >= _ucBalance.size()) return 0;
+    UcBalance balance = _ucBalance[ucId];
+    auto resize = [&](const UCSpecificClass &ucClass, int64_t size) {
+        auto current = (int64_t) _classes.at(ucClass).getStudentsIDs().size();
+        balance.sum += size - current;
+        balance.sumSquares += size * size - current * current;
+    };
+    resize(ucSpecificClassDesired, sizeClassDesired);
+    if (ucSpecificClass != ucSpecificClassDesired) resize(ucSpecificClass, sizeClass);
+    return desvio(balance);
 }
 
 /**
@@ -1209,6 +2233,7 @@ double ScheduleManager::desvioAfterChange(const UCSpecificClass &ucSpecificClass
  * @return Ano da turma.
  */
 char ScheduleManager::displayClassesYears() {
+    SCHEDULE_LATENCY();
     system("clear");
     char ano;
     std::set<char> years;
@@ -1223,7 +2248,9 @@ char ScheduleManager::displayClassesYears() {
     while (true) {
         std::cout << std::endl << "Insira o ano da turma/estudante" << std::endl;
         std::cout << ">>> ";
+        SCHEDULE_LATENCY_PAUSE();
         std::cin >> ano;
+        SCHEDULE_LATENCY_RESUME();
         if (years.find(ano) != years.end()) {
             system("clear");
             return ano;
@@ -1233,11 +2260,26 @@ char ScheduleManager::displayClassesYears() {
 }
 
 /**
- * @brief Permite ordenar a forma de mostrar os alunos.
+ * @brief Obtém os estudantes correspondentes a uma lista de números UP, sem os copiar.
+ * Complexidade: O(N).
+ * @param studentCodes - Números UP, por ordem crescente.
+ * @return Apontadores para os estudantes, pela mesma ordem.
+ */
+template<typename Codes>
+std::vector<const Student *> ScheduleManager::studentsOf(const Codes &studentCodes) const {
+    std::vector<const Student *> students;
+    students.reserve(studentCodes.size());
+    for (unsigned int studentCode: studentCodes) students.push_back(&_students.at(studentCode));
+    return students;
+}
+
+/**
+ * @brief Permite ordenar a forma de mostrar os alunos. Os estudantes chegam por ordem crescente de número UP; a ordem
+ * por nome vem da ordem alfabética pré-calculada na tabela de estudantes (sem distinguir acentos nem maiúsculas).
  * Complexidade: O(N logN).
- * @param students
+ * @param students - Apontadores para os estudantes, por ordem crescente de número UP.
  */
-void ScheduleManager::displaySortedStudents(const std::set<Student> &students) {
+void ScheduleManager::displaySortedStudents(std::vector<const Student *> students) const {
     std::cout << "Introduza a ordenação desejada:" << std::endl;
     std::cout << "1. Nome (ascendente)" << std::endl;
     std::cout << "2. Nome (descendente)" << std::endl;
@@ -1253,35 +2295,26 @@ void ScheduleManager::displaySortedStudents(const std::set<Student> &students) {
         std::cout << "Por favor, introduza um dígito válido." << std::endl;
     }
 
-    std::vector<Student> sorted_students(students.begin(), students.end());
-
     switch (choice) {
         case 1:
-            std::sort(sorted_students.begin(), sorted_students.end(), [](const Student &s1, const Student &s2) {
-                return s1.getName() < s2.getName();
-            });
+            _students.sortByName(students);
             break;
         case 2:
-            std::sort(sorted_students.begin(), sorted_students.end(), [](const Student &s1, const Student &s2) {
-                return s1.getName() > s2.getName();
-            });
+            _students.sortByName(students);
+            std::reverse(students.begin(), students.end());
             break;
         case 3:
-            std::sort(sorted_students.begin(), sorted_students.end(), [](const Student &s1, const Student &s2) {
-                return s1.getStudentCode() < s2.getStudentCode();
-            });
             break;
         case 4:
-            std::sort(sorted_students.begin(), sorted_students.end(), [](const Student &s1, const Student &s2) {
-                return s1.getStudentCode() > s2.getStudentCode();
-            });
+            std::reverse(students.begin(), students.end());
             break;
         default:
             std::cout << "Por favor, introduza um dígito válido." << std::endl;
     }
 
-    for (const auto &student: sorted_students) {
-        std::cout << student.getName() << " - up" << student.getStudentCode() << std::endl;
+    OutputBuffer out = listing();
+    for (const Student *student: students) {
+        out << student->getName() << " - up" << student->getStudentCode() << '\n';
     }
 }
 
@@ -1290,12 +2323,15 @@ void ScheduleManager::displaySortedStudents(const std::set<Student> &students) {
  * Complexidade: O(N^2).
  */
 void ScheduleManager::UpdateStudentsClassesCSV() {
+    SCHEDULE_LATENCY();
+    SCHEDULE_TRACE_SPAN("Escrita do CSV");
+    SCHEDULE_TIME_PHASE(Persistence);
     std::ofstream file;
-    file.open("../schedule/students_classes.csv");
+    file.open(_studentsClassesFile);
     file << "StudentCode,StudentName,UcCode,ClassCode" << std::endl;
-    for (const auto &student: _students) {
-        for (const auto &ucSpecificClass: student.second.getTurmas()) {
-            file << student.second.getStudentCode() << "," << student.second.getName() << ","
+    for (const Student &student: _students) {
+        for (const auto &ucSpecificClass: student.getTurmas()) {
+            file << student.getStudentCode() << "," << student.getName() << ","
                  << ucSpecificClass.getUcCode() << "," << ucSpecificClass.getClassCode() << "\r\n";
         }
     }
@@ -1312,6 +2348,7 @@ void ScheduleManager::UpdateStudentsClassesCSV() {
  * @see UpdateStudentsClassesCSV().
  */
 void ScheduleManager::undoLastRequest() {
+    SCHEDULE_LATENCY();
     // Tentar desfazer a última operação na stack _acceptedRequests. Se for bem-sucedido, dar pop. Se não, perguntar ao utilizador se quer abri-la de qualquer forma.
     if (_acceptedRequests.empty()) {
         std::cout << "Não existem pedidos aceites para desfazer." << std::endl;
@@ -1327,7 +2364,9 @@ void ScheduleManager::undoLastRequest() {
     char choice;
     while (true) {
         std::cout << "Deseja desfazer o pedido? (y/n)" << std::endl;
+        SCHEDULE_LATENCY_PAUSE();
         std::cin >> choice;
+        SCHEDULE_LATENCY_RESUME();
         if (choice == 'y') {
             break;
         }
@@ -1336,24 +2375,22 @@ void ScheduleManager::undoLastRequest() {
         }
     }
     Student *student = findStudent(undo.getStudent().getStudentCode());
-    Class *desiredClass = findClass(undo.getDesiredClass());
     if (undo.gettypeRequest() == "Enrollment") {
-        student->addTurma(undo.getDesiredClass());
-        desiredClass->addStudent(undo.getStudent().getStudentCode());
+        enroll(*student, undo.getDesiredClass());
     } else if (undo.gettypeRequest() == "Removal") {
-        student->removeTurma(desiredClass->getUcClass().getUcCode());
-        desiredClass->removeStudent(student->getStudentCode());
+        unenroll(*student, undo.getDesiredClass());
     } else if (undo.gettypeRequest() == "SwitchClass") {
-        student->changeTurma(undo.getDesiredClass());
-        findClass(student->findUCSpecificClass(undo.getDesiredClass().getUcCode()))->removeStudent(
-                student->getStudentCode());
-        desiredClass->addStudent(student->getStudentCode());
+        switchClass(*student, undo.getDesiredClass());
     } else if (undo.gettypeRequest() == "SwitchUC") {
-        student->removeTurma(undo.getDesiredClass().getUcCode());
-        student->addTurma(UCSpecificClass(undo.getDesiredClass()));
-        findClass(student->findUCSpecificClass(undo.getDesiredClass().getUcCode()))->removeStudent(
-                student->getStudentCode());
-        desiredClass->addStudent(student->getStudentCode());
+        // A UC para onde o aluno mudou é a única que não constava do aluno guardado antes da mudança.
+        Student before = undo.getStudent();
+        for (const UCSpecificClass &turma: student->getTurmas()) {
+            if (!before.isEnrolledUc(turma.getUcCode())) {
+                unenroll(*student, turma);
+                break;
+            }
+        }
+        enroll(*student, undo.getDesiredClass());
     }
     _acceptedRequests.pop();
 
@@ -1371,3 +2408,494 @@ void ScheduleManager::undoLastRequest() {
 
 
 
+
+/**
+ * @brief Mostra uma estimativa da memória ocupada por cada estrutura (estudantes, turmas, aulas e pedidos), obtida
+ * percorrendo todos os dados. Mostra também quanto ocupam as cópias de UCSpecificClass espalhadas pelas estruturas e
+ * quanto ocupariam se fossem guardadas como identificadores compactos de 4 bytes.
+ * Complexidade: O(N + M + R), sendo N o número de inscrições, M o número de aulas e R o número de pedidos.
+ * @param out - Destino do relatório.
+ */
+void ScheduleManager::printMemoryReport(std::ostream &out) const {
+    struct Row {
+        std::string name;
+        size_t count;
+        size_t bytes;
+    };
+    std::vector<Row> rows;
+    size_t ucClassCopies = 0, ucClassHeap = 0;
+
+    size_t names = 0, turmas = 0, enrollments = 0;
+    for (const Student &student: _students) {
+        size_t name = MemoryUsage::string(student.getName());
+        names += name;
+        turmas += student.memoryUsage() - name;
+        enrollments += student.getTurmaIds().size();
+    }
+    size_t studentNodes = _students.memoryUsage();
+    rows.push_back({"Estudantes (tabela)", _students.size(), studentNodes});
+    rows.push_back({"Nomes dos estudantes", _students.size(), names});
+    rows.push_back({"Turmas dos estudantes", enrollments, turmas});
+
+    size_t classNodes = 0, lessons = 0, lessonBytes = 0, members = 0, memberBytes = 0;
+    for (const auto &pair: _classes) {
+        classNodes += MemoryUsage::TREE_NODE_HEADER + sizeof(std::pair<const UCSpecificClass, Class>) +
+                      pair.first.memoryUsage() + pair.second.getUcClass().memoryUsage();
+        ucClassHeap += pair.first.memoryUsage() + pair.second.getUcClass().memoryUsage();
+        lessons += pair.second.getLessons().size();
+        lessonBytes += pair.second.lessonsMemoryUsage();
+        for (const Lesson &lesson: pair.second.getLessons()) ucClassHeap += lesson.getUcSpecificClass().memoryUsage();
+        members += pair.second.getStudentsIDs().size();
+        memberBytes += pair.second.studentsMemoryUsage();
+    }
+    ucClassCopies += 2 * _classes.size() + lessons;
+    rows.push_back({"Turmas (nós do mapa)", _classes.size(), classNodes});
+    rows.push_back({"Aulas", lessons, lessonBytes});
+    rows.push_back({"Alunos das turmas", members, memberBytes});
+
+    size_t pending = 0, pendingBytes = 0;
+    auto requestCopies = [&](const Requests &request) {
+        ucClassCopies++;
+        ucClassHeap += request.getDesiredClass().memoryUsage();
+    };
+    for (const std::queue<Requests> *queue: {&_changeClassRequests, &_removalRequests, &_enrollmentRequests}) {
+        pending += queue->size();
+        pendingBytes += MemoryUsage::dequeBuffers<Requests>(queue->size());
+        for (const Requests &request: MemoryUsage::container(*queue)) {
+            pendingBytes += request.memoryUsage();
+            requestCopies(request);
+        }
+    }
+    pending += _changeUcRequests.size();
+    pendingBytes += MemoryUsage::dequeBuffers<std::pair<Requests, std::string>>(_changeUcRequests.size());
+    for (const auto &pair: MemoryUsage::container(_changeUcRequests)) {
+        pendingBytes += pair.first.memoryUsage() + MemoryUsage::string(pair.second);
+        requestCopies(pair.first);
+    }
+    rows.push_back({"Pedidos pendentes", pending, pendingBytes});
+
+    size_t rejectedBytes = MemoryUsage::vectorBuffer(_rejectedRequests);
+    for (const RejectedRequest &rejected: _rejectedRequests) {
+        rejectedBytes += rejected.request.memoryUsage() + MemoryUsage::string(rejected.reason) +
+                         MemoryUsage::vectorBuffer(rejected.alternatives);
+        requestCopies(rejected.request);
+    }
+    rows.push_back({"Pedidos recusados", _rejectedRequests.size(), rejectedBytes});
+
+    size_t acceptedBytes = MemoryUsage::dequeBuffers<Requests>(_acceptedRequests.size());
+    for (const Requests &request: MemoryUsage::container(_acceptedRequests)) {
+        acceptedBytes += request.memoryUsage();
+        requestCopies(request);
+    }
+    rows.push_back({"Pedidos aceites (anular)", _acceptedRequests.size(), acceptedBytes});
+    rows.push_back({"Tabela de aulas", _lessonTable.size(), _lessonTable.memoryUsage()});
+    rows.push_back({"Índice de lugares livres", _freeSeats.size(), _freeSeats.memoryUsage()});
+    rows.push_back({"Matriz de coinscrição", _coEnrollment.ucs() * _coEnrollment.ucs(), _coEnrollment.memoryUsage()});
+    rows.push_back({"Horários em cache", _scheduleCache.size(), _scheduleCache.memoryUsage()});
+
+    size_t total = 0;
+    for (const Row &row: rows) total += row.bytes;
+    auto perElement = [](size_t bytes, size_t count) { return count == 0 ? 0.0 : double(bytes) / double(count); };
+
+    out << "Memória estimada (bytes):" << std::endl;
+    out << std::setw(12) << "Bytes" << std::setw(12) << "Elementos" << std::setw(14) << "Bytes/elem." << "  Estrutura"
+        << std::endl;
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+    for (const Row &row: rows) {
+        out << std::setw(12) << row.bytes << std::setw(12) << row.count << std::setw(14)
+            << perElement(row.bytes, row.count) << "  " << row.name << std::endl;
+    }
+    out << std::setw(12) << total << std::setw(12) << "" << std::setw(14) << "" << "  Total" << std::endl;
+
+    size_t students = studentNodes + names + turmas;
+    size_t classes = classNodes + lessonBytes + memberBytes;
+    size_t requests = _changeClassRequests.size() + _changeUcRequests.size() + _removalRequests.size() +
+                      _enrollmentRequests.size() + _rejectedRequests.size() + _acceptedRequests.size();
+    out << "Por estudante: " << perElement(students, _students.size()) << " | por turma (com aulas e alunos): "
+        << perElement(classes, _classes.size()) << " | por aula: " << perElement(lessonBytes, lessons)
+        << " | por pedido: " << perElement(pendingBytes + rejectedBytes + acceptedBytes, requests) << std::endl;
+
+    out << "Arena de carregamento: " << _arena.getUsed() << " bytes usados, " << _arena.getReserved()
+        << " reservados." << std::endl;
+
+    size_t ucClassBytes = ucClassCopies * sizeof(UCSpecificClass) + ucClassHeap;
+    out << "Cópias de UCSpecificClass: " << ucClassCopies << " (" << ucClassBytes << " bytes); como identificadores "
+        << "compactos: " << ucClassCopies * sizeof(uint32_t) << " bytes." << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+}
+
+/**
+ * @brief Inscreve um aluno numa turma, atualizando o aluno, a lista de alunos da turma, o histograma do número de
+ * unidades curriculares e a matriz de coinscrição. Todas as alterações de inscrições passam por enroll, unenroll e
+ * switchClass.
+ * Complexidade: O(N), sendo N o número de alunos da turma.
+ * @param student - Aluno.
+ * @param ucClass - Turma.
+ */
+void ScheduleManager::enroll(Student &student, const UCSpecificClass &ucClass) {
+    uint32_t before = student.getTurmaIds().size();
+    student.addTurma(ucClass);
+    _classes.at(ucClass).addStudent(student.getStudentCode());
+    updateUcCount(before, student.getTurmaIds().size());
+    updateOccupancy(ucClass, 1);
+    _coEnrollment.add(_students.position(student), UCSpecificClass::ucIdOf(ucClass.getId()));
+    _scheduleCache.invalidateStudent(student.getStudentCode());
+}
+
+/**
+ * @brief Retira um aluno de uma turma (e da respetiva unidade curricular).
+ * Complexidade: O(N), sendo N o número de alunos da turma.
+ * @param student - Aluno.
+ * @param ucClass - Turma.
+ */
+void ScheduleManager::unenroll(Student &student, const UCSpecificClass &ucClass) {
+    uint32_t before = student.getTurmaIds().size();
+    student.removeTurma(ucClass.getUcCode());
+    _classes.at(ucClass).removeStudent(student.getStudentCode());
+    updateUcCount(before, student.getTurmaIds().size());
+    updateOccupancy(ucClass, -1);
+    _coEnrollment.remove(_students.position(student), UCSpecificClass::ucIdOf(ucClass.getId()));
+    _scheduleCache.invalidateStudent(student.getStudentCode());
+}
+
+/**
+ * @brief Muda um aluno para outra turma da mesma unidade curricular.
+ * Complexidade: O(N), sendo N o número de alunos das turmas.
+ * @param student - Aluno.
+ * @param newClass - Nova turma.
+ * @return Turma antiga.
+ */
+UCSpecificClass ScheduleManager::switchClass(Student &student, const UCSpecificClass &newClass) {
+    UCSpecificClass oldClass = student.changeTurma(newClass);
+    _classes.at(oldClass).removeStudent(student.getStudentCode());
+    _classes.at(newClass).addStudent(student.getStudentCode());
+    updateOccupancy(oldClass, -1);
+    updateOccupancy(newClass, 1);
+    _scheduleCache.invalidateStudent(student.getStudentCode());
+    return oldClass;
+}
+
+/**
+ * @brief Atualiza o número de alunos com pelo menos k unidades curriculares quando um aluno passa de 'before' para
+ * 'after' unidades curriculares. Só muda a contagem dos valores de k entre os dois.
+ * Complexidade: O(|after - before|).
+ * @param before - Número de unidades curriculares antes da alteração.
+ * @param after - Número de unidades curriculares depois da alteração.
+ */
+void ScheduleManager::updateUcCount(uint32_t before, uint32_t after) {
+    if (_studentsWithAtLeast.size() <= after) _studentsWithAtLeast.resize(after + 1, 0);
+    for (uint32_t k = before + 1; k <= after; k++) _studentsWithAtLeast[k]++;
+    for (uint32_t k = after + 1; k <= before; k++) _studentsWithAtLeast[k]--;
+}
+
+/**
+ * @brief Recalcula o número de alunos com pelo menos k unidades curriculares, para todos os k.
+ * Complexidade: O(N + K), sendo N o número de alunos.
+ */
+void ScheduleManager::rebuildUcCountHistogram() {
+    _studentsWithAtLeast.assign(1, 0);
+    for (const Student &student: _students) {
+        uint32_t ucs = student.getTurmaIds().size();
+        if (_studentsWithAtLeast.size() <= ucs) _studentsWithAtLeast.resize(ucs + 1, 0);
+        _studentsWithAtLeast[ucs]++;
+    }
+    for (size_t k = _studentsWithAtLeast.size() - 1; k-- > 0;) _studentsWithAtLeast[k] += _studentsWithAtLeast[k + 1];
+}
+
+/**
+ * @brief Permite obter o número de alunos inscritos em pelo menos n unidades curriculares.
+ * Complexidade: O(1).
+ * @param n - Número mínimo de unidades curriculares.
+ * @return Número de alunos.
+ */
+unsigned int ScheduleManager::countStudentsWithAtLeast(int n) const {
+    if (n <= 0) return _students.size();
+    return size_t(n) < _studentsWithAtLeast.size() ? _studentsWithAtLeast[n] : 0;
+}
+
+/**
+ * @brief Permite obter a distribuição do número de unidades curriculares por aluno.
+ * Complexidade: O(K), sendo K o maior número de unidades curriculares de um aluno.
+ * @return Número de alunos inscritos em exatamente k unidades curriculares, para cada k.
+ */
+std::vector<unsigned int> ScheduleManager::getUcCountHistogram() const {
+    std::vector<unsigned int> histogram(_studentsWithAtLeast.size());
+    for (size_t k = 0; k < histogram.size(); k++) {
+        histogram[k] = _studentsWithAtLeast[k] - (k + 1 < _studentsWithAtLeast.size() ? _studentsWithAtLeast[k + 1] : 0);
+    }
+    return histogram;
+}
+
+/**
+ * @brief Atualiza o índice de ocupação de uma turma e da respetiva unidade curricular, os agregados usados para
+ * calcular o desvio padrão das turmas da unidade curricular, os lugares livres da turma e o mapa de ocupação
+ * semanal (se já estiver calculado).
+ * Complexidade: O(log N), sendo N o número de turmas.
+ * @param ucClass - Turma.
+ * @param delta - Variação do número de alunos.
+ */
+void ScheduleManager::updateOccupancy(const UCSpecificClass &ucClass, int delta) {
+    _classOccupancy.add(ucClass, delta);
+    _ucOccupancy.add(ucClass.getUcCode(), delta);
+    UcBalance &balance = _ucBalance[UCSpecificClass::ucIdOf(ucClass.getId())];
+    int64_t after = _classOccupancy.count(ucClass), before = after - delta;
+    balance.sum += delta;
+    balance.sumSquares += after * after - before * before;
+    int64_t capacity = maxCapacity(ucClass);
+    _freeSeats.set(ucClass.getId(), after < capacity ? capacity - after : 0);
+    if (_heatmapBuilt) _heatmap.add(_lessonTable, ucClass.getId(), delta);
+}
+
+/**
+ * @brief Recalcula o índice de ocupação, os agregados de balanceamento e os lugares livres de todas as turmas e
+ * unidades curriculares. O mapa de ocupação semanal só é recalculado na consulta seguinte, para não depender de a
+ * tabela de aulas já estar construída.
+ * Complexidade: O(N log N), sendo N o número de turmas.
+ */
+void ScheduleManager::rebuildOccupancy() {
+    _classOccupancy.clear();
+    _ucOccupancy.clear();
+    _ucBalance.clear();
+    _freeSeats.clear();
+    _heatmapBuilt = false;
+    std::map<std::string, unsigned int> ucs;
+    for (const auto &turma: _classes) {
+        int64_t size = turma.second.getStudentsIDs().size(), capacity = turma.second.getCapacity();
+        _classOccupancy.set(turma.first, size);
+        _freeSeats.set(turma.first.getId(), size < capacity ? capacity - size : 0);
+        ucs[turma.first.getUcCode()] += size;
+        uint16_t ucId = UCSpecificClass::ucIdOf(turma.first.getId());
+        if (_ucBalance.size() <= ucId) _ucBalance.resize(ucId + 1);
+        _ucBalance[ucId].classes++;
+        _ucBalance[ucId].sum += size;
+        _ucBalance[ucId].sumSquares += size * size;
+    }
+    for (const auto &uc: ucs) {
+        _ucOccupancy.set(uc.first, uc.second);
+    }
+}
+
+/**
+ * @brief Recalcula a matriz de coinscrição a partir das turmas de todos os alunos. Tem de ser chamado sempre que a
+ * tabela de estudantes é reconstruída, porque as posições dos alunos mudam.
+ * Complexidade: O(N * K + U^2 * N / 64), sendo N o número de alunos, K o número de turmas de cada aluno e U o número de
+ * UCs.
+ */
+void ScheduleManager::rebuildCoEnrollment() {
+    SCHEDULE_TRACE_SPAN("rebuildCoEnrollment");
+    _coEnrollment.reset(_students.size(), _ucBalance.size());
+    for (const Student &student: _students) {
+        uint32_t position = _students.position(student);
+        for (uint32_t id: student.getTurmaIds()) _coEnrollment.set(position, UCSpecificClass::ucIdOf(id));
+    }
+    _coEnrollment.compute();
+}
+
+/**
+ * @brief Permite obter os códigos e identificadores das UCs que têm turmas.
+ * Complexidade: O(C), sendo C o número de turmas.
+ * @return Pares (código, identificador), por ordem do código.
+ */
+std::vector<std::pair<std::string, uint16_t>> ScheduleManager::ucsWithClasses() const {
+    std::vector<std::pair<std::string, uint16_t>> ucs;
+    for (const auto &turma: _classes) {
+        if (ucs.empty() || ucs.back().first != turma.first.getUcCode()) {
+            ucs.emplace_back(turma.first.getUcCode(), UCSpecificClass::ucIdOf(turma.first.getId()));
+        }
+    }
+    return ucs;
+}
+
+/**
+ * @brief Recalcula o mapa de ocupação semanal de todas as turmas a partir da tabela de aulas. A partir daqui o mapa é
+ * mantido incrementalmente por updateOccupancy, até rebuildOccupancy o invalidar.
+ * Complexidade: O(C log C + L + S), sendo C o número de turmas, L o número de aulas e S o número de meias horas da
+ * semana.
+ */
+void ScheduleManager::rebuildHeatmap() const {
+    _heatmap.clear();
+    for (const auto &turma: _classes) {
+        _heatmap.add(_lessonTable, turma.first.getId(), turma.second.getStudentsIDs().size());
+    }
+    _heatmapBuilt = true;
+}
+
+/**
+ * @brief Permite obter as K unidades curriculares com mais alunos.
+ * Complexidade: O(K + log N).
+ * @param k - Número de unidades curriculares.
+ * @return Unidades curriculares e número de alunos, por ordem decrescente.
+ */
+std::vector<OccupancyIndex<std::string>::Entry> ScheduleManager::getMostFilledUcs(size_t k) const {
+    return _ucOccupancy.mostFilled(k);
+}
+
+/**
+ * @brief Permite obter as K unidades curriculares com menos alunos.
+ * Complexidade: O(K).
+ * @param k - Número de unidades curriculares.
+ * @return Unidades curriculares e número de alunos, por ordem crescente.
+ */
+std::vector<OccupancyIndex<std::string>::Entry> ScheduleManager::getLeastFilledUcs(size_t k) const {
+    return _ucOccupancy.leastFilled(k);
+}
+
+/**
+ * @brief Permite obter as K turmas com mais alunos.
+ * Complexidade: O(K + log N).
+ * @param k - Número de turmas.
+ * @return Turmas e número de alunos, por ordem decrescente.
+ */
+std::vector<OccupancyIndex<UCSpecificClass>::Entry> ScheduleManager::getMostFilledClasses(size_t k) const {
+    return _classOccupancy.mostFilled(k);
+}
+
+/**
+ * @brief Permite obter as K turmas com menos alunos.
+ * Complexidade: O(K).
+ * @param k - Número de turmas.
+ * @return Turmas e número de alunos, por ordem crescente.
+ */
+std::vector<OccupancyIndex<UCSpecificClass>::Entry> ScheduleManager::getLeastFilledClasses(size_t k) const {
+    return _classOccupancy.leastFilled(k);
+}
+
+/**
+ * @brief Permite obter as turmas com no máximo 'margin' lugares livres (incluindo as que estão cheias).
+ * Complexidade: O(M log M + log N), sendo M o número de turmas devolvidas.
+ * @param margin - Número máximo de lugares livres.
+ * @return Turmas e número de alunos, por ordem crescente do número de alunos.
+ */
+std::vector<OccupancyIndex<UCSpecificClass>::Entry> ScheduleManager::getClassesNearCapacity(unsigned int margin) const {
+    std::vector<OccupancyIndex<UCSpecificClass>::Entry> result;
+    for (const auto &entry: _freeSeats.atMost(margin)) {
+        UCSpecificClass ucClass = UCSpecificClass::fromId(entry.first);
+        result.emplace_back(ucClass, _classOccupancy.count(ucClass));
+    }
+    std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+        return a.second != b.second ? a.second < b.second : a.first < b.first;
+    });
+    return result;
+}
+
+/**
+ * @brief Ordena as aulas de um horário e formata o respetivo texto.
+ * Complexidade: O(L log L), sendo L o número de aulas.
+ * @param lessons - Aulas.
+ * @return Horário, pronto a guardar na cache.
+ */
+ScheduleCache::Entry ScheduleManager::buildSchedule(std::vector<const Lesson *> lessons) {
+    std::sort(lessons.begin(), lessons.end(), [](const Lesson *a, const Lesson *b) { return *a < *b; });
+
+    std::ostringstream text;
+    int currentDay = -1;
+    for (const Lesson *lesson: lessons) {
+        if (lesson->getDayValue() != currentDay) {
+            currentDay = lesson->getDayValue();
+            text << lesson->getWeekDay() << ":" << std::endl;
+        }
+
+        text << ScheduleManager::normalizeHours(lesson->getStartTime()) << " to "
+             << ScheduleManager::normalizeHours(lesson->getStartTime() + lesson->getDuration()) << " -> "
+             << lesson->getUcSpecificClass().getClassCode() << ' '
+             << ucCodeToName(lesson->getUcSpecificClass().getUcCode()) << " ("
+             << lesson->getUcType() << ")" << std::endl;
+    }
+    return {std::move(lessons), text.str()};
+}
+
+/**
+ * @brief Permite obter o horário de um aluno, calculando-o e guardando-o na cache se ainda não lá estiver.
+ * Complexidade: O(log N) se estiver em cache, O(L log L) caso contrário, sendo L o número de aulas.
+ * @param up - Número UP do aluno.
+ * @return Horário do aluno.
+ */
+const ScheduleCache::Entry &ScheduleManager::studentSchedule(unsigned int up) {
+    if (const ScheduleCache::Entry *cached = _scheduleCache.findStudent(up)) return *cached;
+    std::vector<const Lesson *> lessons;
+    for (const UCSpecificClass &turma: _students.at(up).getTurmas()) {
+        auto it = _classes.find(turma);
+        if (it == _classes.end()) continue;
+        for (const Lesson &lesson: it->second.getLessons()) {
+            lessons.push_back(&lesson);
+        }
+    }
+    return _scheduleCache.storeStudent(up, buildSchedule(std::move(lessons)));
+}
+
+/**
+ * @brief Permite obter o horário de uma turma (de todas as UCs com esse código de turma), calculando-o e guardando-o
+ * na cache se ainda não lá estiver.
+ * Complexidade: O(log N) se estiver em cache, O(N + L log L) caso contrário.
+ * @param classCode - Código da turma.
+ * @return Horário da turma.
+ */
+const ScheduleCache::Entry &ScheduleManager::classSchedule(const std::string &classCode) {
+    if (const ScheduleCache::Entry *cached = _scheduleCache.findClass(classCode)) return *cached;
+    std::vector<const Lesson *> lessons;
+    for (const auto &pair: _classes) {
+        if (pair.first.getClassCode() == classCode) {
+            for (const Lesson &lesson: pair.second.getLessons()) {
+                lessons.push_back(&lesson);
+            }
+        }
+    }
+    return _scheduleCache.storeClass(classCode, buildSchedule(std::move(lessons)));
+}
+
+/**
+ * @brief Permite obter o horário de uma unidade curricular, calculando-o e guardando-o na cache se ainda não lá
+ * estiver.
+ * Complexidade: O(log N) se estiver em cache, O(N + L log L) caso contrário.
+ * @param ucCode - Código da UC.
+ * @return Horário da unidade curricular.
+ */
+const ScheduleCache::Entry &ScheduleManager::ucSchedule(const std::string &ucCode) {
+    if (const ScheduleCache::Entry *cached = _scheduleCache.findUc(ucCode)) return *cached;
+    std::vector<const Lesson *> lessons;
+    for (const auto &pair: _classes) {
+        if (pair.first.getUcCode() == ucCode) {
+            for (const Lesson &lesson: pair.second.getLessons()) {
+                lessons.push_back(&lesson);
+            }
+        }
+    }
+    return _scheduleCache.storeUc(ucCode, buildSchedule(std::move(lessons)));
+}
+
+/**
+ * @brief Define o ficheiro para onde são escritas as listagens longas (alunos, pedidos pendentes e recusados), em vez
+ * do terminal.
+ * Complexidade: O(1).
+ * @param file - Ficheiro (vazio para voltar a escrever no terminal).
+ * @return Verdadeiro se o ficheiro foi aberto, falso caso contrário.
+ */
+bool ScheduleManager::setListingFile(const std::string &file) {
+    if (_listingFile.is_open()) _listingFile.close();
+    if (file.empty()) return true;
+    _listingFile.open(file);
+    return _listingFile.is_open();
+}
+
+/**
+ * @brief Define o paginador (por exemplo "less") usado para mostrar as listagens longas no terminal.
+ * Complexidade: O(1).
+ * @param command - Comando do paginador (vazio para escrever diretamente no terminal).
+ */
+void ScheduleManager::setPager(const std::string &command) {
+    _pager = command;
+}
+
+/**
+ * @brief Cria o buffer de escrita de uma listagem, para o ficheiro de listagens se estiver definido, ou para o
+ * terminal (através do paginador, se existir).
+ * Complexidade: O(1).
+ * @return Buffer da listagem.
+ */
+OutputBuffer ScheduleManager::listing() const {
+    if (_listingFile.is_open()) return OutputBuffer(_listingFile);
+    return OutputBuffer(std::cout, _pager);
+}
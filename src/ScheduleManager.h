@@ -10,9 +10,21 @@
 #include <iomanip>
 #include <algorithm>
 #include <stack>
+#include <fstream>
+#include "Arena.h"
 #include "Student.h"
+#include "StudentTable.h"
 #include "Class.h"
 #include "Requests.h"
+#include "OccupancyIndex.h"
+#include "FreeSeatIndex.h"
+#include "OccupancyHeatmap.h"
+#include "CoEnrollmentMatrix.h"
+#include "ScheduleCache.h"
+#include "OutputBuffer.h"
+#include "UcCatalog.h"
+#include "LessonTable.h"
+#include "TimetableGenerator.h"
 
 /**
  * @brief Classe que permite obter informações dos horários (seja turma ou uc), dos pedidos e dos estudantes.
@@ -21,12 +33,31 @@
 class ScheduleManager {
 
 public:
+    /** @brief Desvio padrão do número de alunos das turmas de uma UC acima do qual as turmas não estão equilibradas. */
+    static constexpr double BALANCE_THRESHOLD = 4;
+    /** @brief Hora a partir da qual são procurados horários livres comuns. */
+    static constexpr float FREE_TIME_START = 8;
+    /** @brief Hora até à qual são procurados horários livres comuns. */
+    static constexpr float FREE_TIME_END = 20;
+    /** @brief Número de dias (a partir de segunda-feira) onde são procurados horários livres comuns. */
+    static constexpr unsigned int FREE_TIME_DAYS = 5;
+
     ScheduleManager();
 
     void load_classes(const std::string &file);
 
     void load_students_classes(const std::string &file);
 
+    bool load_ucs(const std::string &file);
+
+    bool load_capacities(const std::string &file);
+
+    unsigned int load_requests(const std::string &file);
+
+    unsigned int enrollCohort(const std::string &file);
+
+    void setStudentsClassesFile(const std::string &file);
+
     unsigned int displayAllStudents();
 
     void displayStudentsPerYear(const std::string& year);
@@ -51,6 +82,26 @@ public:
 
     void displayMostFilledUc();
 
+    void displayOccupancy(unsigned int k, unsigned int margin);
+
+    void displayCommonFreeTime(const std::vector<unsigned int> &studentCodes, float minHours);
+
+    void displayOccupancyHeatmap(char year, const std::string &ucCode, const std::string &lessonType);
+
+    [[nodiscard]] OccupancyHeatmap::Counts occupancyHeatmap(char year = 0, const std::string &ucCode = "", const std::string &lessonType = "") const;
+
+    bool exportOccupancyHeatmap(const std::string &file) const;
+
+    void displayCoEnrollment(const std::string &ucCode);
+
+    [[nodiscard]] unsigned int commonStudents(const std::string &ucA, const std::string &ucB) const;
+
+    bool exportCoEnrollment(const std::string &file) const;
+
+    [[nodiscard]] std::vector<FreeWindow> commonFreeTime(const std::vector<unsigned int> &studentCodes, float minHours) const;
+
+    [[nodiscard]] std::vector<FreeWindow> commonFreeTime(const UCSpecificClass &ucClass, float minHours) const;
+
     static std::string normalizeHours(float horas);
 
     static std::string ucCodeToName(const std::string &ucCode);
@@ -85,17 +136,31 @@ public:
 
     void addEnrollmentRequest(const Student &student, const UCSpecificClass &ucSpecificClass);
 
+    void SubmitTimetableRequest(Student* student);
+
+    [[nodiscard]] std::vector<Timetable> generateTimetables(const Student &student, const std::vector<std::string> &ucCodes, size_t count) const;
+
     bool overlapClasses(const UCSpecificClass &ucSpecificClass, const UCSpecificClass &ucSpecificClassDesired);
 
+    [[nodiscard]] std::vector<UCSpecificClass> compatibleClasses(const Student &student, const std::string &ucCode, const std::string &ignoredUc = "") const;
+
+    [[nodiscard]] std::vector<uint32_t> suggestAlternatives(const Student &student, const UCSpecificClass &rejectedClass, const std::string &ignoredUc = "") const;
+
+    [[nodiscard]] const std::vector<RejectedRequest> &getRejectedRequests() const;
+
     bool exceedsCapacity(const Requests &request);
 
-    static unsigned int maxCapacity(const UCSpecificClass &ucSpecificClass);
+    [[nodiscard]] unsigned int maxCapacity(const UCSpecificClass &ucSpecificClass) const;
+
+    [[nodiscard]] int64_t classWithFreeSeats(const std::string &ucCode) const;
+
+    [[nodiscard]] int64_t bestClassFor(const Student &student, const std::string &ucCode, const std::string &ignoredUc = "") const;
 
     bool balancedClasses(const UCSpecificClass &ucSpecificClass, const UCSpecificClass &ucSpecificClassDesired);
 
-    double desvioClasses(const UCSpecificClass &ucSpecificClass);
+    double desvioClasses(const UCSpecificClass &ucSpecificClass) const;
 
-    double desvioAfterChange(const UCSpecificClass &ucSpecificClass, const UCSpecificClass &ucSpecificClassDesired, const unsigned int &sizeClass, const unsigned int &sizeClassDesired);
+    double desvioAfterChange(const UCSpecificClass &ucSpecificClass, const UCSpecificClass &ucSpecificClassDesired, const unsigned int &sizeClass, const unsigned int &sizeClassDesired) const;
 
     void processRemovalRequests(const Requests& request);
 
@@ -107,15 +172,44 @@ public:
 
     void processRequests();
 
+    void processPendingRequests();
+
+    unsigned int rebalanceClasses();
+
     char displayClassesYears();
 
     void undoLastRequest();
 
+    void UpdateStudentsClassesCSV();
+
+    void printMemoryReport(std::ostream &out) const;
+
+    bool setListingFile(const std::string &file);
+
+    void setPager(const std::string &command);
+
+    [[nodiscard]] unsigned int countStudentsWithAtLeast(int n) const;
+
+    [[nodiscard]] std::vector<unsigned int> getUcCountHistogram() const;
+
+    [[nodiscard]] std::vector<OccupancyIndex<std::string>::Entry> getMostFilledUcs(size_t k) const;
+
+    [[nodiscard]] std::vector<OccupancyIndex<std::string>::Entry> getLeastFilledUcs(size_t k) const;
+
+    [[nodiscard]] std::vector<OccupancyIndex<UCSpecificClass>::Entry> getMostFilledClasses(size_t k) const;
+
+    [[nodiscard]] std::vector<OccupancyIndex<UCSpecificClass>::Entry> getLeastFilledClasses(size_t k) const;
+
+    [[nodiscard]] std::vector<OccupancyIndex<UCSpecificClass>::Entry> getClassesNearCapacity(unsigned int margin) const;
+
 private:
+    /** @brief Arena onde são alocados os estudantes, os nós de _classes e os vetores de aulas. Tem de ser declarada
+     * antes de _students e _classes, para ser destruída depois deles. */
+    Arena _arena;
     /** @brief Permite obter informações de um aluno em específico usando o seu número UP que está associado ao objeto 'Student', tendo assim acesso aos seus atributos. */
-    std::map<unsigned int, Student> _students;
+    StudentTable _students;
     /** @brief Permite mapear uma turma específica (UCSpecificClass) a um objeto da classe 'Class', obtendo acesso aos seus atributos (horário e alunos matriculados). */
-    std::map<UCSpecificClass, Class> _classes;
+    std::pmr::map<UCSpecificClass, Class> _classes;
     /** @brief Armazena-se os pedidos de troca de turma. */
     std::queue<Requests> _changeClassRequests;
     /** @brief Armazena-s os pedidos de troca de UC. */
@@ -125,13 +219,88 @@ private:
     /** @brief Armazena-se os pedidos de inscrição numa UC. */
     std::queue<Requests> _enrollmentRequests;
     /** @brief Armazena-se os pedidos que foram rejectados após processamento. */
-    std::vector<std::pair<Requests, std::string>> _rejectedRequests;
+    std::vector<RejectedRequest> _rejectedRequests;
     /** @brief Armazena-se os pedidos que foram aceites após processamento. */
     std::stack<Requests> _acceptedRequests;
+    /** @brief Número de alunos inscritos em pelo menos k unidades curriculares (índice k); a posição 0 conta todos. */
+    std::vector<unsigned int> _studentsWithAtLeast;
+    /** @brief Número de alunos de cada turma, ordenado por ocupação. */
+    OccupancyIndex<UCSpecificClass> _classOccupancy;
+    /** @brief Número de alunos de cada unidade curricular, ordenado por ocupação. */
+    OccupancyIndex<std::string> _ucOccupancy;
+    /** @brief Número de turmas, soma e soma dos quadrados do número de alunos das turmas de cada UC (indexado pelo
+     * identificador da UC), para calcular o desvio padrão sem percorrer as turmas. */
+    struct UcBalance {
+        int64_t classes = 0;
+        int64_t sum = 0;
+        int64_t sumSquares = 0;
+    };
+    std::vector<UcBalance> _ucBalance;
+    /** @brief Lugares livres de cada turma, ordenados dentro de cada UC. */
+    FreeSeatIndex _freeSeats;
+    /** @brief Número de alunos em aula em cada meia hora da semana, por tipo de aula. */
+    mutable OccupancyHeatmap _heatmap;
+    /** @brief Falso se o mapa de ocupação semanal tiver de ser recalculado antes da próxima consulta. */
+    mutable bool _heatmapBuilt = false;
+    /** @brief Número de alunos inscritos em cada par de UCs (indexado pelos identificadores das UCs). */
+    CoEnrollmentMatrix _coEnrollment;
+    /** @brief Aulas de todas as turmas, com a máscara da semana de cada turma, para testar sobreposições. */
+    LessonTable _lessonTable;
+    /** @brief Horários já calculados de alunos, turmas e unidades curriculares. */
+    ScheduleCache _scheduleCache;
+    /** @brief Catálogo das unidades curriculares (partilhado, porque é usado por funções estáticas). */
+    static UcCatalog _catalog;
+    /** @brief Ficheiro onde são escritas as listagens, se estiver aberto. */
+    mutable std::ofstream _listingFile;
+    /** @brief Comando do paginador das listagens no terminal (vazio se não for usado). */
+    std::string _pager;
+    /** @brief Ficheiro CSV onde são guardadas as turmas dos estudantes. */
+    std::string _studentsClassesFile = "../schedule/students_classes.csv";
+    template<typename Codes>
+    std::vector<const Student *> studentsOf(const Codes &studentCodes) const;
+
+    void enroll(Student &student, const UCSpecificClass &ucClass);
+
+    void unenroll(Student &student, const UCSpecificClass &ucClass);
+
+    UCSpecificClass switchClass(Student &student, const UCSpecificClass &newClass);
+
+    void updateUcCount(uint32_t before, uint32_t after);
+
+    void rebuildUcCountHistogram();
+
+    void updateOccupancy(const UCSpecificClass &ucClass, int delta);
+
+    void rebuildOccupancy();
+
+    void rebuildHeatmap() const;
+
+    void rebuildCoEnrollment();
+
+    [[nodiscard]] std::vector<std::pair<std::string, uint16_t>> ucsWithClasses() const;
+
+    [[nodiscard]] std::vector<uint32_t> compatibleClassIds(const Student &student, const std::string &ucCode, const std::string &ignoredUc) const;
+
+    [[nodiscard]] bool keepsBalance(const UCSpecificClass &ucSpecificClass, const UCSpecificClass &ucSpecificClassDesired) const;
+
+    static double desvio(const UcBalance &balance);
+
+    void reject(const Requests &request, const std::string &reason, std::vector<uint32_t> alternatives = {});
+
+    void printCompatibleClasses(const Student &student, const std::string &ucCode, const std::string &ignoredUc = "") const;
+
+    static ScheduleCache::Entry buildSchedule(std::vector<const Lesson *> lessons);
+
+    const ScheduleCache::Entry &studentSchedule(unsigned int up);
+
+    const ScheduleCache::Entry &classSchedule(const std::string &classCode);
+
+    const ScheduleCache::Entry &ucSchedule(const std::string &ucCode);
+
+    [[nodiscard]] OutputBuffer listing() const;
+
     /** @brief Permite escolher a forma de visualização da lista de estudantes (alfabética ou numérica). */
-    static void displaySortedStudents(const std::set<Student>& students);
-    /** @brief Atualiiza o ficheiro CSV com os pedidos de troca de turma. */
-    void UpdateStudentsClassesCSV();
+    void displaySortedStudents(std::vector<const Student *> students) const;
 
 };
 
@@ -0,0 +1,225 @@
+#ifndef PROJECT_1_SCHEDULE_SMALLVECTOR_H
+#define PROJECT_1_SCHEDULE_SMALLVECTOR_H
+
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Vetor que guarda até N elementos dentro do próprio objeto e só passa a usar memória dinâmica quando excede
+ * essa capacidade. Apenas para tipos trivialmente copiáveis (por exemplo identificadores inteiros).
+ */
+
+template<typename T, unsigned int N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable_v<T>, "SmallVector só suporta tipos trivialmente copiáveis");
+
+public:
+
+    /**
+     * @brief Construtor default da classe SmallVector.
+     * Complexidade: O(1).
+     */
+    SmallVector() = default;
+
+    /**
+     * @brief Construtor de cópia da classe SmallVector.
+     * Complexidade: O(N).
+     * @param other - Vetor a copiar.
+     */
+    SmallVector(const SmallVector &other) {
+        reserve(other._size);
+        std::memcpy(data(), other.data(), other._size * sizeof(T));
+        _size = other._size;
+    }
+
+    /**
+     * @brief Construtor de movimento da classe SmallVector. A memória dinâmica, se existir, passa para o novo vetor.
+     * Complexidade: O(N) se os elementos estiverem dentro do objeto, O(1) caso contrário.
+     * @param other - Vetor a mover.
+     */
+    SmallVector(SmallVector &&other) noexcept {
+        takeContents(other);
+    }
+
+    /**
+     * @brief Operador de atribuição por cópia.
+     * Complexidade: O(N).
+     * @param other - Vetor a copiar.
+     * @return Este vetor.
+     */
+    SmallVector &operator=(const SmallVector &other) {
+        if (this != &other) {
+            _size = 0;
+            reserve(other._size);
+            std::memcpy(data(), other.data(), other._size * sizeof(T));
+            _size = other._size;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Operador de atribuição por movimento.
+     * Complexidade: O(N) se os elementos estiverem dentro do objeto, O(1) caso contrário.
+     * @param other - Vetor a mover.
+     * @return Este vetor.
+     */
+    SmallVector &operator=(SmallVector &&other) noexcept {
+        if (this != &other) {
+            release();
+            takeContents(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destrutor da classe SmallVector.
+     * Complexidade: O(1).
+     */
+    ~SmallVector() {
+        release();
+    }
+
+    /**
+     * @brief Permite obter o número de elementos.
+     * Complexidade: O(1).
+     * @return Número de elementos.
+     */
+    [[nodiscard]] uint32_t size() const { return _size; }
+
+    /**
+     * @brief Verifica se o vetor está vazio.
+     * Complexidade: O(1).
+     * @return Verdadeiro se não tiver elementos.
+     */
+    [[nodiscard]] bool empty() const { return _size == 0; }
+
+    /**
+     * @brief Permite obter a capacidade atual.
+     * Complexidade: O(1).
+     * @return Número de elementos que cabem sem realocar.
+     */
+    [[nodiscard]] uint32_t capacity() const { return _heap == nullptr ? N : _capacity; }
+
+    /**
+     * @brief Verifica se os elementos estão em memória dinâmica.
+     * Complexidade: O(1).
+     * @return Verdadeiro se o vetor excedeu a capacidade interna.
+     */
+    [[nodiscard]] bool isSpilled() const { return _heap != nullptr; }
+
+    T *data() { return _heap == nullptr ? _inline : _heap; }
+
+    [[nodiscard]] const T *data() const { return _heap == nullptr ? _inline : _heap; }
+
+    T *begin() { return data(); }
+
+    T *end() { return data() + _size; }
+
+    [[nodiscard]] const T *begin() const { return data(); }
+
+    [[nodiscard]] const T *end() const { return data() + _size; }
+
+    T &operator[](uint32_t i) { return data()[i]; }
+
+    const T &operator[](uint32_t i) const { return data()[i]; }
+
+    /**
+     * @brief Garante capacidade para pelo menos n elementos.
+     * Complexidade: O(N).
+     * @param n - Número de elementos.
+     */
+    void reserve(uint32_t n) {
+        if (n <= capacity()) return;
+        T *heap = new T[n];
+        std::memcpy(heap, data(), _size * sizeof(T));
+        delete[] _heap;
+        _heap = heap;
+        _capacity = n;
+    }
+
+    /**
+     * @brief Adiciona um elemento no fim.
+     * Complexidade: O(1) amortizado.
+     * @param value - Elemento a adicionar.
+     */
+    void push_back(const T &value) {
+        if (_size == capacity()) reserve(capacity() * 2);
+        data()[_size++] = value;
+    }
+
+    /**
+     * @brief Insere um elemento na posição indicada, deslocando os seguintes.
+     * Complexidade: O(N).
+     * @param position - Posição onde inserir.
+     * @param value - Elemento a inserir.
+     */
+    void insert(const T *position, const T &value) {
+        uint32_t index = position - data();
+        if (_size == capacity()) reserve(capacity() * 2);
+        std::memmove(data() + index + 1, data() + index, (_size - index) * sizeof(T));
+        data()[index] = value;
+        _size++;
+    }
+
+    /**
+     * @brief Remove o elemento na posição indicada, deslocando os seguintes.
+     * Complexidade: O(N).
+     * @param position - Posição do elemento a remover.
+     */
+    void erase(const T *position) {
+        uint32_t index = position - data();
+        std::memmove(data() + index, data() + index + 1, (_size - index - 1) * sizeof(T));
+        _size--;
+    }
+
+    /**
+     * @brief Remove todos os elementos, mantendo a capacidade.
+     * Complexidade: O(1).
+     */
+    void clear() { _size = 0; }
+
+private:
+    /** @brief Elementos em memória dinâmica, ou nullptr enquanto cabem em _inline. */
+    T *_heap = nullptr;
+    /** @brief Número de elementos. */
+    uint32_t _size = 0;
+    /** @brief Capacidade da memória dinâmica. */
+    uint32_t _capacity = 0;
+    /** @brief Elementos guardados dentro do objeto. */
+    T _inline[N];
+
+    /**
+     * @brief Liberta a memória dinâmica e esvazia o vetor.
+     * Complexidade: O(1).
+     */
+    void release() {
+        delete[] _heap;
+        _heap = nullptr;
+        _size = 0;
+        _capacity = 0;
+    }
+
+    /**
+     * @brief Passa o conteúdo de outro vetor para este vetor, que tem de estar vazio e sem memória
+     * dinâmica; o outro vetor fica vazio.
+     * Complexidade: O(N) se os elementos estiverem dentro do objeto, O(1) caso contrário.
+     * @param other - Vetor de origem.
+     */
+    void takeContents(SmallVector &other) {
+        if (other._heap != nullptr) {
+            _heap = other._heap;
+            _capacity = other._capacity;
+        } else {
+            std::memcpy(_inline, other._inline, other._size * sizeof(T));
+        }
+        _size = other._size;
+        other._heap = nullptr;
+        other._size = 0;
+        other._capacity = 0;
+    }
+};
+
+
+#endif //PROJECT_1_SCHEDULE_SMALLVECTOR_H
@@ -1,4 +1,5 @@
 #include "Student.h"
+#include "MemoryUsage.h"
 
 /**
  * @brief Construtor default da classe Student.
@@ -34,20 +35,44 @@ const std::string &Student::getName() const {
 
 /**
  * @brief Permite obter as turmas às quais o estudante pertence.
+ * Complexidade: O(N).
+ * @return Vetor com as turmas às quais o estudante pertence, ordenadas por UC.
+ */
+std::vector<UCSpecificClass> Student::getTurmas() const {
+    std::vector<UCSpecificClass> turmas;
+    turmas.reserve(_turmas.size());
+    for (uint32_t id: _turmas) turmas.push_back(UCSpecificClass::fromId(id));
+    return turmas;
+}
+
+/**
+ * @brief Permite obter os identificadores compactos das turmas do estudante, sem construir UCSpecificClass.
  * Complexidade: O(1).
- * @return Vetor com as turmas às quais o estudante pertence.
+ * @return Identificadores das turmas, ordenados por UC.
  */
-const std::vector<UCSpecificClass> &Student::getTurmas() const {
+const SmallVector<uint32_t, Student::MAX_INLINE_TURMAS> &Student::getTurmaIds() const {
     return _turmas;
 }
 
 /**
- * @brief Permite adicionar uma turma ao vetor de turmas do estudante.
- * Complexidade: O(1).
+ * @brief Reserva espaço para o número de turmas indicado, para que o vetor não tenha de crescer durante o carregamento.
+ * Complexidade: O(N).
+ * @param n - Número de turmas.
+ */
+void Student::reserveTurmas(size_t n) {
+    _turmas.reserve(n);
+}
+
+/**
+ * @brief Permite adicionar uma turma ao estudante, mantendo as turmas ordenadas por UC.
+ * Complexidade: O(N).
  * @param ucSpecificClass - Turma a adicionar.
  */
 void Student::addTurma(const UCSpecificClass &ucSpecificClass) {
-    _turmas.push_back(ucSpecificClass);
+    uint32_t id = ucSpecificClass.getId();
+    const uint32_t *position = _turmas.begin();
+    while (position != _turmas.end() && *position < id) position++;
+    _turmas.insert(position, id);
 }
 
 /**
@@ -57,10 +82,11 @@ void Student::addTurma(const UCSpecificClass &ucSpecificClass) {
  * @return Turma antiga.
  */
 UCSpecificClass Student::changeTurma(const UCSpecificClass &newTurma) {
-    for (auto & turma : _turmas) {
-        if (turma.getUcCode() == newTurma.getUcCode()) {
-            UCSpecificClass oldTurma = turma;
-            turma = newTurma;
+    uint32_t id = newTurma.getId();
+    for (uint32_t &turma: _turmas) {
+        if (UCSpecificClass::ucIdOf(turma) == UCSpecificClass::ucIdOf(id)) {
+            UCSpecificClass oldTurma = UCSpecificClass::fromId(turma);
+            turma = id;
             return oldTurma;
         }
     }
@@ -68,14 +94,15 @@ UCSpecificClass Student::changeTurma(const UCSpecificClass &newTurma) {
 }
 
 /**
- * @brief Permite remover uma turma do vetor de turmas do estudante.
+ * @brief Permite remover uma turma do estudante.
  * Complexidade: O(N).
- * @param ucCode - Id da turma a remover.
+ * @param ucCode - Id da UC da turma a remover.
  */
 void Student::removeTurma(const std::string &ucCode) {
-    for (int i = 0; i < _turmas.size(); i++) {
-        if (_turmas.at(i).getUcCode() == ucCode) {
-            _turmas.erase(_turmas.begin() + i);
+    int ucId = UCSpecificClass::findUcId(ucCode);
+    for (const uint32_t &turma: _turmas) {
+        if (int(UCSpecificClass::ucIdOf(turma)) == ucId) {
+            _turmas.erase(&turma);
             return;
         }
     }
@@ -83,17 +110,16 @@ void Student::removeTurma(const std::string &ucCode) {
 
 /**
  * @brief Permite verificar se um estudante está matriculado numa determinada UC.
+ * Percorre os identificadores sem saltos condicionais, já que estão todos dentro do objeto.
  * Complexidade: O(N).
  * @param ucCode - Id da UC.
  * @return Verdadeiro se o estudante estiver matriculado na UC, falso caso contrário.
  */
 bool Student::isEnrolledUc(const std::string &ucCode) const {
-    for (const UCSpecificClass &turma: _turmas) {
-        if (turma.getUcCode() == ucCode) {
-            return true;
-        }
-    }
-    return false;
+    int ucId = UCSpecificClass::findUcId(ucCode);
+    bool enrolled = false;
+    for (uint32_t turma: _turmas) enrolled |= int(UCSpecificClass::ucIdOf(turma)) == ucId;
+    return enrolled;
 }
 
 /**
@@ -103,9 +129,10 @@ bool Student::isEnrolledUc(const std::string &ucCode) const {
  * @return Turma específica.
  */
 UCSpecificClass Student::findUCSpecificClass(const std::string &ucCode) const {
-    for (const UCSpecificClass &turma: _turmas) {
-        if (turma.getUcCode() == ucCode) {
-            return turma;
+    int ucId = UCSpecificClass::findUcId(ucCode);
+    for (uint32_t turma: _turmas) {
+        if (int(UCSpecificClass::ucIdOf(turma)) == ucId) {
+            return UCSpecificClass::fromId(turma);
         }
     }
     return {};
@@ -146,3 +173,14 @@ bool Student::operator>(const Student &rhs) const {
 
 
 
+
+/**
+ * @brief Estima a memória dinâmica ocupada pelo estudante (nome e, se excederem a capacidade interna, turmas).
+ * Complexidade: O(1).
+ * @return Número de bytes.
+ */
+size_t Student::memoryUsage() const {
+    size_t bytes = MemoryUsage::string(_name);
+    if (_turmas.isSpilled()) bytes += MemoryUsage::heapBlock(_turmas.capacity() * sizeof(uint32_t));
+    return bytes;
+}
@@ -2,16 +2,22 @@
 #define PROJECT_1_SCHEDULE_STUDENT_H
 
 
+#include <cstdint>
 #include <string>
 #include <vector>
+#include "SmallVector.h"
 #include "UCSpecificClass.h"
 
 /**
  * @brief Classe que representa um aluno, armazenando informações essenciais sobre o mesmo.
+ * As turmas são guardadas como identificadores compactos (UCSpecificClass::getId), ordenados por UC, dentro do
+ * próprio objeto; só um aluno com mais de MAX_INLINE_TURMAS turmas usa memória dinâmica.
  */
 
 class Student {
 public:
+    /** @brief Número de turmas guardadas dentro do objeto. */
+    static const unsigned int MAX_INLINE_TURMAS = 7;
 
     Student(unsigned int studentCode, std::string name);
 
@@ -21,7 +27,11 @@ public:
 
     [[nodiscard]] const std::string &getName() const;
 
-    [[nodiscard]] const std::vector <UCSpecificClass> &getTurmas() const;
+    [[nodiscard]] std::vector <UCSpecificClass> getTurmas() const;
+
+    [[nodiscard]] const SmallVector<uint32_t, MAX_INLINE_TURMAS> &getTurmaIds() const;
+
+    void reserveTurmas(size_t n);
 
     void addTurma(const UCSpecificClass &ucSpecificClass);
 
@@ -33,6 +43,8 @@ public:
 
     [[nodiscard]] UCSpecificClass findUCSpecificClass(const std::string &ucCode) const;
 
+    [[nodiscard]] size_t memoryUsage() const;
+
     bool operator == (const Student &rhs) const;
 
     bool operator < (const Student &rhs) const;
@@ -44,8 +56,8 @@ private:
     unsigned int _studentCode{};
     /** @brief Nome do estudante. */
     std::string _name;
-    /** @brief Turmas às quais pertence. */
-    std::vector <UCSpecificClass> _turmas;
+    /** @brief Identificadores das turmas às quais pertence, ordenados por UC. */
+    SmallVector<uint32_t, MAX_INLINE_TURMAS> _turmas;
 };
 
 
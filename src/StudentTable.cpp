@@ -0,0 +1,266 @@
+#include "StudentTable.h"
+#include "Collation.h"
+#include "MemoryUsage.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Construtor da classe StudentTable.
+ * Complexidade: O(1).
+ * @param resource - Recurso de memória onde são guardados os estudantes.
+ */
+StudentTable::StudentTable(std::pmr::memory_resource *resource) : _students(resource) {}
+
+/**
+ * @brief Reserva espaço para o número de estudantes indicado.
+ * Complexidade: O(N).
+ * @param n - Número de estudantes.
+ */
+void StudentTable::reserve(size_t n) {
+    _students.reserve(n);
+}
+
+/**
+ * @brief Adiciona um estudante durante o carregamento, ou devolve o existente com o mesmo número UP.
+ * A tabela só pode ser consultada depois de build().
+ * Complexidade: O(1) em média.
+ * @param studentCode - Número UP.
+ * @param name - Nome do estudante.
+ * @return Estudante (válido até à próxima chamada de add ou build).
+ */
+Student &StudentTable::add(unsigned int studentCode, const std::string &name) {
+    if (_loading.empty() && !_students.empty()) {
+        for (uint32_t i = 0; i < _students.size(); i++) _loading.emplace(_students[i].getStudentCode(), i);
+    }
+    auto it = _loading.find(studentCode);
+    if (it != _loading.end()) return _students[it->second];
+    _loading.emplace(studentCode, uint32_t(_students.size()));
+    _students.emplace_back(studentCode, name);
+    return _students.back();
+}
+
+/**
+ * @brief Ordena os estudantes por número UP e constrói os vetores de endereçamento direto de cada prefixo.
+ * Complexidade: O(N logN + P), sendo P o número de prefixos.
+ */
+void StudentTable::build() {
+    _loading.clear();
+    std::sort(_students.begin(), _students.end());
+    _ranges.clear();
+    _rangeOfPrefix.clear();
+    if (_students.empty()) return;
+
+    _minPrefix = _students.front().getStudentCode() / PREFIX_DIVISOR;
+    _rangeOfPrefix.assign(_students.back().getStudentCode() / PREFIX_DIVISOR - _minPrefix + 1, EMPTY);
+    for (uint32_t i = 0; i < _students.size();) {
+        uint32_t prefix = _students[i].getStudentCode() / PREFIX_DIVISOR;
+        uint32_t first = i;
+        while (i < _students.size() && _students[i].getStudentCode() / PREFIX_DIVISOR == prefix) i++;
+
+        Range range;
+        range.minOffset = _students[first].getStudentCode() % PREFIX_DIVISOR;
+        uint32_t span = _students[i - 1].getStudentCode() % PREFIX_DIVISOR - range.minOffset + 1;
+        while ((span - 1) >> range.shift >= i - first) range.shift++;
+        range.bucketStart.assign(((span - 1) >> range.shift) + 2, i);
+        for (uint32_t j = i; j-- > first;) {
+            range.bucketStart[(_students[j].getStudentCode() % PREFIX_DIVISOR - range.minOffset) >> range.shift] = j;
+        }
+        for (size_t b = range.bucketStart.size() - 1; b-- > 0;) {
+            range.bucketStart[b] = std::min(range.bucketStart[b], range.bucketStart[b + 1]);
+        }
+
+        _rangeOfPrefix[prefix - _minPrefix] = _ranges.size();
+        _ranges.push_back(std::move(range));
+    }
+    buildNameOrder();
+}
+
+/**
+ * @brief Calcula a ordem alfabética dos estudantes: por chave de Collation, depois pelo nome tal como está escrito e
+ * por fim pelo número UP. As chaves só são usadas durante a ordenação.
+ * Complexidade: O(N logN).
+ */
+void StudentTable::buildNameOrder() {
+    std::vector<std::string> keys;
+    keys.reserve(_students.size());
+    for (const Student &student: _students) keys.push_back(Collation::key(student.getName()));
+
+    _byName.resize(_students.size());
+    for (uint32_t i = 0; i < _byName.size(); i++) _byName[i] = i;
+    std::sort(_byName.begin(), _byName.end(), [&](uint32_t a, uint32_t b) {
+        if (keys[a] != keys[b]) return keys[a] < keys[b];
+        if (_students[a].getName() != _students[b].getName()) return _students[a].getName() < _students[b].getName();
+        return a < b;
+    });
+    _nameRank.resize(_students.size());
+    for (uint32_t rank = 0; rank < _byName.size(); rank++) _nameRank[_byName[rank]] = rank;
+}
+
+/**
+ * @brief Permite obter a posição de um estudante da tabela na ordem alfabética.
+ * Complexidade: O(1).
+ * @param student - Estudante guardado nesta tabela.
+ * @return Posição na ordem alfabética.
+ */
+uint32_t StudentTable::nameRank(const Student &student) const {
+    return _nameRank[&student - _students.data()];
+}
+
+/**
+ * @brief Permite obter a posição de um estudante da tabela (de 0 a size() - 1, por ordem de número UP). A posição só
+ * muda quando build() é chamado.
+ * Complexidade: O(1).
+ * @param student - Estudante guardado nesta tabela.
+ * @return Posição na tabela.
+ */
+uint32_t StudentTable::position(const Student &student) const {
+    return &student - _students.data();
+}
+
+/**
+ * @brief Ordena uma lista de estudantes da tabela por nome. Listas pequenas são ordenadas pela posição na ordem
+ * alfabética (inteiros); listas com uma fração grande dos estudantes são obtidas filtrando a ordem alfabética global.
+ * Complexidade: O(K logK) ou O(N), o que for menor, sendo K o tamanho da lista e N o número de estudantes.
+ * @param students - Estudantes guardados nesta tabela, sem repetições.
+ */
+void StudentTable::sortByName(std::vector<const Student *> &students) const {
+    if (students.size() * 8 < _students.size()) {
+        std::sort(students.begin(), students.end(), [this](const Student *a, const Student *b) {
+            return nameRank(*a) < nameRank(*b);
+        });
+        return;
+    }
+    std::vector<bool> selected(_students.size());
+    for (const Student *student: students) selected[student - _students.data()] = true;
+    students.clear();
+    for (uint32_t index: _byName) {
+        if (selected[index]) students.push_back(&_students[index]);
+    }
+}
+
+/**
+ * @brief Obtém a posição de um estudante em _students.
+ * Complexidade: O(1) em média.
+ * @param studentCode - Número UP.
+ * @return Posição do estudante, ou EMPTY se não existir.
+ */
+uint32_t StudentTable::indexOf(unsigned int studentCode) const {
+    uint32_t prefix = studentCode / PREFIX_DIVISOR;
+    if (prefix < _minPrefix || prefix - _minPrefix >= _rangeOfPrefix.size()) return EMPTY;
+    uint32_t rangeIndex = _rangeOfPrefix[prefix - _minPrefix];
+    if (rangeIndex == EMPTY) return EMPTY;
+    const Range &range = _ranges[rangeIndex];
+
+    uint32_t offset = studentCode % PREFIX_DIVISOR;
+    if (offset < range.minOffset) return EMPTY;
+    uint32_t bucket = (offset - range.minOffset) >> range.shift;
+    if (bucket + 1 >= range.bucketStart.size()) return EMPTY;
+    for (uint32_t i = range.bucketStart[bucket]; i < range.bucketStart[bucket + 1]; i++) {
+        if (_students[i].getStudentCode() == studentCode) return i;
+    }
+    return EMPTY;
+}
+
+/**
+ * @brief Permite encontrar um estudante.
+ * Complexidade: O(1) em média.
+ * @param studentCode - Número UP.
+ * @return Estudante, ou nullptr se não existir.
+ */
+Student *StudentTable::find(unsigned int studentCode) {
+    uint32_t index = indexOf(studentCode);
+    return index == EMPTY ? nullptr : &_students[index];
+}
+
+/**
+ * @brief Permite encontrar um estudante.
+ * Complexidade: O(1) em média.
+ * @param studentCode - Número UP.
+ * @return Estudante, ou nullptr se não existir.
+ */
+const Student *StudentTable::find(unsigned int studentCode) const {
+    uint32_t index = indexOf(studentCode);
+    return index == EMPTY ? nullptr : &_students[index];
+}
+
+/**
+ * @brief Permite obter um estudante que tem de existir.
+ * Complexidade: O(1) em média.
+ * @param studentCode - Número UP.
+ * @return Estudante.
+ * @throws std::out_of_range se o estudante não existir.
+ */
+Student &StudentTable::at(unsigned int studentCode) {
+    Student *student = find(studentCode);
+    if (student == nullptr) throw std::out_of_range("StudentTable::at");
+    return *student;
+}
+
+/**
+ * @brief Permite obter um estudante que tem de existir.
+ * Complexidade: O(1) em média.
+ * @param studentCode - Número UP.
+ * @return Estudante.
+ * @throws std::out_of_range se o estudante não existir.
+ */
+const Student &StudentTable::at(unsigned int studentCode) const {
+    const Student *student = find(studentCode);
+    if (student == nullptr) throw std::out_of_range("StudentTable::at");
+    return *student;
+}
+
+/**
+ * @brief Permite obter o número de estudantes.
+ * Complexidade: O(1).
+ * @return Número de estudantes.
+ */
+size_t StudentTable::size() const {
+    return _students.size();
+}
+
+/**
+ * @brief Início dos estudantes, por ordem de número UP.
+ * Complexidade: O(1).
+ */
+std::pmr::vector<Student>::iterator StudentTable::begin() {
+    return _students.begin();
+}
+
+/**
+ * @brief Fim dos estudantes.
+ * Complexidade: O(1).
+ */
+std::pmr::vector<Student>::iterator StudentTable::end() {
+    return _students.end();
+}
+
+/**
+ * @brief Início dos estudantes, por ordem de número UP.
+ * Complexidade: O(1).
+ */
+std::pmr::vector<Student>::const_iterator StudentTable::begin() const {
+    return _students.begin();
+}
+
+/**
+ * @brief Fim dos estudantes.
+ * Complexidade: O(1).
+ */
+std::pmr::vector<Student>::const_iterator StudentTable::end() const {
+    return _students.end();
+}
+
+/**
+ * @brief Estima a memória ocupada pela tabela (vetor de estudantes, vetores diretos e ordem alfabética), sem contar a
+ * memória dinâmica de cada estudante.
+ * Complexidade: O(P), sendo P o número de prefixos.
+ * @return Número de bytes.
+ */
+size_t StudentTable::memoryUsage() const {
+    size_t bytes = MemoryUsage::vectorBuffer(_students) + MemoryUsage::vectorBuffer(_rangeOfPrefix) +
+                   MemoryUsage::vectorBuffer(_ranges);
+    for (const Range &range: _ranges) bytes += MemoryUsage::vectorBuffer(range.bucketStart);
+    bytes += MemoryUsage::vectorBuffer(_byName) + MemoryUsage::vectorBuffer(_nameRank);
+    return bytes;
+}
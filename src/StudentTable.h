@@ -0,0 +1,99 @@
+#ifndef PROJECT_1_SCHEDULE_STUDENTTABLE_H
+#define PROJECT_1_SCHEDULE_STUDENTTABLE_H
+
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Student.h"
+
+/**
+ * @brief Tabela de estudantes guardados de forma contígua e ordenados por número UP.
+ * Os números UP agrupam-se por ano de inscrição (202025232 -> prefixo 2020, deslocamento 25232). Para cada prefixo,
+ * os deslocamentos são divididos em baldes de 2^shift números, com shift escolhido para que haja no máximo um balde
+ * por estudante, e um vetor de endereçamento direto guarda a posição do primeiro estudante de cada balde. Encontrar um
+ * estudante custa uma divisão, dois acessos a vetores e a comparação com os poucos estudantes do balde (em prefixos
+ * densos, shift = 0 e cada balde tem no máximo um estudante).
+ * Os estudantes são adicionados durante o carregamento e a tabela é construída com build(); depois disso os
+ * endereços dos estudantes não mudam.
+ * build() calcula também a ordem alfabética de todos os estudantes (com chaves de Collation) e a posição de cada um
+ * nessa ordem, para que qualquer lista de estudantes possa ser ordenada por nome comparando inteiros.
+ */
+
+class StudentTable {
+public:
+    /** @brief Divisor que separa o prefixo (ano) do deslocamento dentro do ano. */
+    static constexpr unsigned int PREFIX_DIVISOR = 100000;
+
+    explicit StudentTable(std::pmr::memory_resource *resource);
+
+    void reserve(size_t n);
+
+    Student &add(unsigned int studentCode, const std::string &name);
+
+    void build();
+
+    [[nodiscard]] Student *find(unsigned int studentCode);
+
+    [[nodiscard]] const Student *find(unsigned int studentCode) const;
+
+    Student &at(unsigned int studentCode);
+
+    [[nodiscard]] const Student &at(unsigned int studentCode) const;
+
+    [[nodiscard]] size_t size() const;
+
+    std::pmr::vector<Student>::iterator begin();
+
+    std::pmr::vector<Student>::iterator end();
+
+    [[nodiscard]] std::pmr::vector<Student>::const_iterator begin() const;
+
+    [[nodiscard]] std::pmr::vector<Student>::const_iterator end() const;
+
+    [[nodiscard]] uint32_t nameRank(const Student &student) const;
+
+    [[nodiscard]] uint32_t position(const Student &student) const;
+
+    void sortByName(std::vector<const Student *> &students) const;
+
+    [[nodiscard]] size_t memoryUsage() const;
+
+private:
+    /** @brief Conjunto de números UP com o mesmo prefixo. */
+    struct Range {
+        /** @brief Menor deslocamento do prefixo. */
+        uint32_t minOffset = 0;
+        /** @brief Cada balde cobre 2^shift deslocamentos. */
+        uint32_t shift = 0;
+        /** @brief Posição em _students do primeiro estudante de cada balde (mais uma posição final). */
+        std::vector<uint32_t> bucketStart;
+    };
+
+    /** @brief Marca uma posição do vetor direto sem estudante. */
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    /** @brief Estudantes, ordenados por número UP depois de build(). */
+    std::pmr::vector<Student> _students;
+    /** @brief Menor prefixo presente. */
+    uint32_t _minPrefix = 0;
+    /** @brief Índice em _ranges de cada prefixo (a partir de _minPrefix), ou EMPTY. */
+    std::vector<uint32_t> _rangeOfPrefix;
+    /** @brief Conjuntos de números UP, um por prefixo. */
+    std::vector<Range> _ranges;
+    /** @brief Posições dos estudantes em _students, por ordem alfabética. */
+    std::vector<uint32_t> _byName;
+    /** @brief Posição de cada estudante (pela ordem de _students) na ordem alfabética. */
+    std::vector<uint32_t> _nameRank;
+    /** @brief Posição de cada estudante durante o carregamento, antes de build(). */
+    std::unordered_map<unsigned int, uint32_t> _loading;
+
+    [[nodiscard]] uint32_t indexOf(unsigned int studentCode) const;
+
+    void buildNameOrder();
+};
+
+
+#endif //PROJECT_1_SCHEDULE_STUDENTTABLE_H
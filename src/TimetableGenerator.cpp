@@ -0,0 +1,217 @@
+#include "TimetableGenerator.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+/**
+ * @brief Construtor da classe TimetableGenerator.
+ * As UCs são reordenadas por número crescente de turmas candidatas, para que a árvore de procura seja mais estreita
+ * no topo e as sobreposições cortem os ramos mais cedo.
+ * Complexidade: O(U log U + T), sendo U o número de UCs e T o número de turmas candidatas.
+ * @param options - Turmas candidatas de cada UC, pela ordem das UCs pedidas.
+ * @param busy - Meias horas ocupadas pelas aulas não teóricas que o aluno já tem.
+ * @param occupied - Meias horas ocupadas por todas as aulas que o aluno já tem.
+ * @param table - Tabela das aulas das turmas candidatas.
+ */
+TimetableGenerator::TimetableGenerator(std::vector<std::vector<TimetableOption>> options,
+                                       const LessonTable::Mask &busy, const LessonTable::Mask &occupied,
+                                       const LessonTable &table)
+        : _busy(busy), _occupied(occupied), _exact(table.isAligned() ? nullptr : &table) {
+    _ucOrder.resize(options.size());
+    std::iota(_ucOrder.begin(), _ucOrder.end(), 0);
+    std::stable_sort(_ucOrder.begin(), _ucOrder.end(),
+                     [&](size_t a, size_t b) { return options[a].size() < options[b].size(); });
+    for (size_t uc: _ucOrder) _options.push_back(std::move(options[uc]));
+
+    _minRemainingCost.assign(_options.size() + 1, 0);
+    for (size_t depth = _options.size(); depth-- > 0;) {
+        double cheapest = std::numeric_limits<double>::infinity();
+        for (const TimetableOption &option: _options[depth]) cheapest = std::min(cheapest, option.balanceCost);
+        _minRemainingCost[depth] = _minRemainingCost[depth + 1] + cheapest;
+    }
+}
+
+/**
+ * @brief Gera os melhores horários sem sobreposições.
+ * Complexidade: O(T^U) no pior caso, sendo U o número de UCs e T o número de turmas de cada UC; na prática as
+ * sobreposições e o limite dos melhores horários cortam a maior parte dos ramos.
+ * @param count - Número máximo de horários.
+ * @param threads - Número de threads (0 para usar todas as do processador).
+ * @return Horários, do melhor para o pior.
+ */
+std::vector<Timetable> TimetableGenerator::generate(size_t count, unsigned int threads) const {
+    if (count == 0) return {};
+    for (const std::vector<TimetableOption> &options: _options) {
+        if (options.empty()) return {};
+    }
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<Branch> branches = split(4 * threads);
+    threads = std::min<size_t>(threads, branches.size());
+    std::atomic<double> bound(std::numeric_limits<double>::infinity());
+    std::atomic<size_t> next(0);
+    std::vector<Search> searches(std::max(1u, threads), Search{count, &bound, {}});
+
+    auto worker = [&](Search &state) {
+        for (size_t i = next++; i < branches.size(); i = next++) search(branches[i], state);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned int t = 1; t < threads; t++) pool.emplace_back(worker, std::ref(searches[t]));
+    worker(searches[0]);
+    for (std::thread &thread: pool) thread.join();
+
+    std::vector<Timetable> best;
+    for (Search &state: searches) {
+        best.insert(best.end(), std::make_move_iterator(state.best.begin()), std::make_move_iterator(state.best.end()));
+    }
+    std::sort(best.begin(), best.end(), better);
+    if (best.size() > count) best.resize(count);
+    return best;
+}
+
+/**
+ * @brief Verifica se uma turma candidata se sobrepõe às turmas já escolhidas num ramo. As turmas candidatas já não se
+ * sobrepõem às que o aluno mantém. Com máscaras exatas basta intersetá-las; caso contrário (aulas fora da meia hora
+ * certa ou de dia desconhecido), as aulas são comparadas uma a uma.
+ * Complexidade: O(1) com máscaras exatas; O(K * A^2) caso contrário, sendo K o número de turmas escolhidas e A o
+ * número de aulas de cada turma.
+ * @param busy - Meias horas ocupadas pelas aulas não teóricas do ramo.
+ * @param chosen - Turmas escolhidas no ramo.
+ * @param option - Turma candidata.
+ * @return Verdadeiro se houver sobreposição, falso caso contrário.
+ */
+bool TimetableGenerator::clashes(const LessonTable::Mask &busy, const std::vector<uint32_t> &chosen,
+                                 const TimetableOption &option) const {
+    if (_exact == nullptr) return LessonTable::intersects(busy, option.busy);
+    for (uint32_t classId: chosen) {
+        if (_exact->conflicts(classId, option.classId)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Divide a árvore de procura em ramos independentes, descendo nível a nível até haver pelo menos 'minBranches'
+ * ramos (ou até escolher uma turma de todas as UCs).
+ * Complexidade: O(R * T), sendo R o número de ramos gerados e T o número de turmas de cada UC.
+ * @param minBranches - Número mínimo de ramos pretendido.
+ * @return Ramos, pela ordem da procura.
+ */
+std::vector<TimetableGenerator::Branch> TimetableGenerator::split(size_t minBranches) const {
+    std::vector<Branch> branches = {{{}, _busy, _occupied, 0}};
+    for (size_t depth = 0; depth < _options.size() && branches.size() < minBranches; depth++) {
+        std::vector<Branch> deeper;
+        for (const Branch &branch: branches) {
+            for (const TimetableOption &option: _options[depth]) {
+                if (clashes(branch.busy, branch.chosen, option)) continue;
+                Branch child = branch;
+                child.chosen.push_back(option.classId);
+                LessonTable::merge(child.busy, option.busy);
+                LessonTable::merge(child.occupied, option.occupied);
+                child.balanceCost += option.balanceCost;
+                deeper.push_back(std::move(child));
+            }
+        }
+        branches = std::move(deeper);
+    }
+    return branches;
+}
+
+/**
+ * @brief Percorre em profundidade um ramo da procura, guardando os horários completos que encontrar.
+ * Complexidade: O(T^K), sendo K o número de UCs que faltam escolher no ramo.
+ * @param branch - Ramo (as turmas escolhidas são acrescentadas e retiradas durante a procura).
+ * @param state - Melhores horários da thread.
+ */
+void TimetableGenerator::search(Branch &branch, Search &state) const {
+    size_t depth = branch.chosen.size();
+    if (branch.balanceCost + _minRemainingCost[depth] > state.bound->load(std::memory_order_relaxed)) return;
+    if (depth == _options.size()) {
+        offer(branch, state);
+        return;
+    }
+    Branch parent = {{}, branch.busy, branch.occupied, branch.balanceCost};
+    for (const TimetableOption &option: _options[depth]) {
+        if (clashes(parent.busy, branch.chosen, option)) continue;
+        branch.chosen.push_back(option.classId);
+        branch.busy = parent.busy;
+        branch.occupied = parent.occupied;
+        LessonTable::merge(branch.busy, option.busy);
+        LessonTable::merge(branch.occupied, option.occupied);
+        branch.balanceCost = parent.balanceCost + option.balanceCost;
+        search(branch, state);
+        branch.chosen.pop_back();
+    }
+    branch.busy = parent.busy;
+    branch.occupied = parent.occupied;
+    branch.balanceCost = parent.balanceCost;
+}
+
+/**
+ * @brief Considera um horário completo para os melhores horários de uma thread e, se estes ficarem cheios, baixa o
+ * limite partilhado para a pior pontuação que lá entra.
+ * Complexidade: O(log N + U), sendo N o número de horários pedidos e U o número de UCs.
+ * @param branch - Ramo completo.
+ * @param state - Melhores horários da thread.
+ */
+void TimetableGenerator::offer(const Branch &branch, Search &state) const {
+    Timetable timetable;
+    timetable.classIds.resize(branch.chosen.size());
+    for (size_t depth = 0; depth < branch.chosen.size(); depth++) {
+        timetable.classIds[_ucOrder[depth]] = branch.chosen[depth];
+    }
+    timetable.balanceCost = branch.balanceCost;
+    timetable.gaps = countGaps(branch.occupied);
+    timetable.score = timetable.balanceCost + GAP_WEIGHT * timetable.gaps;
+
+    std::vector<Timetable> &best = state.best;
+    if (best.size() == state.count) {
+        if (!better(timetable, best.front())) return;
+        std::pop_heap(best.begin(), best.end(), better);
+        best.back() = std::move(timetable);
+    } else {
+        best.push_back(std::move(timetable));
+    }
+    std::push_heap(best.begin(), best.end(), better);
+
+    if (best.size() == state.count) {
+        double worst = best.front().score;
+        double current = state.bound->load(std::memory_order_relaxed);
+        while (worst < current && !state.bound->compare_exchange_weak(current, worst, std::memory_order_relaxed));
+    }
+}
+
+/**
+ * @brief Ordem dos horários: menor pontuação primeiro e, em caso de empate, menores identificadores, para que o
+ * resultado não dependa da divisão do trabalho pelas threads.
+ * Complexidade: O(U), sendo U o número de UCs.
+ * @param a - Primeiro horário.
+ * @param b - Segundo horário.
+ * @return Verdadeiro se 'a' for melhor que 'b', falso caso contrário.
+ */
+bool TimetableGenerator::better(const Timetable &a, const Timetable &b) {
+    if (a.score != b.score) return a.score < b.score;
+    return a.classIds < b.classIds;
+}
+
+/**
+ * @brief Conta as meias horas livres entre a primeira e a última aula de cada dia.
+ * Complexidade: O(D), sendo D o número de dias.
+ * @param occupied - Meias horas ocupadas.
+ * @return Número de meias horas livres.
+ */
+unsigned int TimetableGenerator::countGaps(const LessonTable::Mask &occupied) {
+    const uint64_t dayMask = (uint64_t(1) << LessonTable::SLOTS_PER_DAY) - 1;
+    unsigned int gaps = 0;
+    for (unsigned int day = 0; day < LessonTable::DAYS; day++) {
+        unsigned int offset = day * LessonTable::SLOTS_PER_DAY, word = offset / 64, shift = offset % 64;
+        uint64_t slots = occupied[word] >> shift;
+        if (shift + LessonTable::SLOTS_PER_DAY > 64) slots |= occupied[word + 1] << (64 - shift);
+        slots &= dayMask;
+        if (slots == 0) continue;
+        int first = __builtin_ctzll(slots), last = 63 - __builtin_clzll(slots);
+        gaps += last - first + 1 - __builtin_popcountll(slots);
+    }
+    return gaps;
+}
@@ -0,0 +1,108 @@
+#ifndef PROJECT_1_SCHEDULE_TIMETABLEGENERATOR_H
+#define PROJECT_1_SCHEDULE_TIMETABLEGENERATOR_H
+
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "LessonTable.h"
+
+/**
+ * @brief Turma candidata de uma unidade curricular, com as suas máscaras da semana e o custo de inscrever o aluno.
+ */
+
+struct TimetableOption {
+    /** @brief Identificador compacto da turma. */
+    uint32_t classId;
+    /** @brief Meias horas ocupadas pelas aulas não teóricas da turma. */
+    LessonTable::Mask busy;
+    /** @brief Meias horas ocupadas por todas as aulas da turma. */
+    LessonTable::Mask occupied;
+    /** @brief Variação do desvio padrão das turmas da UC se o aluno for inscrito nesta turma. */
+    double balanceCost;
+};
+
+/**
+ * @brief Horário gerado: uma turma por unidade curricular.
+ */
+
+struct Timetable {
+    /** @brief Identificadores compactos das turmas, pela ordem das unidades curriculares pedidas. */
+    std::vector<uint32_t> classIds;
+    /** @brief Soma das variações do desvio padrão das turmas de cada UC. */
+    double balanceCost = 0;
+    /** @brief Meias horas livres entre a primeira e a última aula de cada dia, somadas ao longo da semana. */
+    unsigned int gaps = 0;
+    /** @brief Pontuação do horário (menor é melhor): balanceCost + GAP_WEIGHT * gaps. */
+    double score = 0;
+};
+
+/**
+ * @brief Procura, entre todas as combinações de uma turma por UC, os horários sem sobreposições com menor pontuação.
+ * A procura é feita em profundidade, começando pelas UCs com menos turmas: cada turma só é escolhida se a sua máscara
+ * não intersetar a máscara das turmas já escolhidas (ou, se as máscaras da tabela de aulas não forem exatas, se nenhuma
+ * aula se sobrepuser às dessas turmas), e um ramo é abandonado se nem com as turmas mais baratas das UCs
+ * que faltam conseguir entrar nos melhores horários já encontrados.
+ * Os ramos do topo da árvore são distribuídos por várias threads; cada thread guarda os seus melhores horários e
+ * partilha com as outras a pior pontuação que ainda lá entra, para que todas podem os ramos com o mesmo limite.
+ */
+
+class TimetableGenerator {
+public:
+    /** @brief Peso de cada meia hora livre entre aulas na pontuação de um horário. */
+    static constexpr double GAP_WEIGHT = 0.05;
+
+    TimetableGenerator(std::vector<std::vector<TimetableOption>> options, const LessonTable::Mask &busy,
+                       const LessonTable::Mask &occupied, const LessonTable &table);
+
+    [[nodiscard]] std::vector<Timetable> generate(size_t count, unsigned int threads = 0) const;
+
+private:
+    /** @brief Turmas candidatas de cada UC, pela ordem em que as UCs são percorridas. */
+    std::vector<std::vector<TimetableOption>> _options;
+    /** @brief Posição de cada UC (pela ordem em que são percorridas) na lista de UCs pedida. */
+    std::vector<size_t> _ucOrder;
+    /** @brief Menor custo possível das UCs a partir de cada profundidade (com uma posição extra, a 0). */
+    std::vector<double> _minRemainingCost;
+    /** @brief Meias horas ocupadas pelas aulas não teóricas que o aluno já tem. */
+    LessonTable::Mask _busy;
+    /** @brief Meias horas ocupadas por todas as aulas que o aluno já tem. */
+    LessonTable::Mask _occupied;
+    /** @brief Tabela das aulas, para comparar as aulas das turmas quando as máscaras não são exatas (nulo se forem). */
+    const LessonTable *_exact;
+
+    /**
+     * @brief Estado de um ramo da procura: as turmas escolhidas até uma certa profundidade.
+     */
+    struct Branch {
+        std::vector<uint32_t> chosen;
+        LessonTable::Mask busy;
+        LessonTable::Mask occupied;
+        double balanceCost;
+    };
+
+    /**
+     * @brief Melhores horários encontrados por uma thread.
+     */
+    struct Search {
+        size_t count;
+        std::atomic<double> *bound;
+        std::vector<Timetable> best;
+    };
+
+    [[nodiscard]] bool clashes(const LessonTable::Mask &busy, const std::vector<uint32_t> &chosen,
+                               const TimetableOption &option) const;
+
+    [[nodiscard]] std::vector<Branch> split(size_t minBranches) const;
+
+    void search(Branch &branch, Search &state) const;
+
+    void offer(const Branch &branch, Search &state) const;
+
+    static bool better(const Timetable &a, const Timetable &b);
+
+    static unsigned int countGaps(const LessonTable::Mask &occupied);
+};
+
+
+#endif //PROJECT_1_SCHEDULE_TIMETABLEGENERATOR_H
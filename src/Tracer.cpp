@@ -0,0 +1,183 @@
+#include "Tracer.h"
+
+#ifdef SCHEDULE_INSTRUMENTATION
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+namespace {
+    /** @brief Evento completo ("ph": "X") do formato trace_event. */
+    struct Event {
+        const char *name;
+        std::string detail;
+        double start;
+        double duration;
+    };
+
+    /** @brief Eventos registados por uma thread. */
+    struct ThreadEvents {
+        unsigned int tid;
+        std::vector<Event> events;
+    };
+
+    /**
+     * @brief Estado global do registo: ficheiro de destino, instante zero e eventos de todas as threads.
+     * Os eventos de threads terminadas passam para 'retired'.
+     */
+    struct TraceState {
+        std::mutex mutex;
+        std::atomic<bool> enabled{false};
+        std::string file;
+        std::chrono::steady_clock::time_point origin;
+        std::vector<ThreadEvents *> threads;
+        std::vector<ThreadEvents> retired;
+        unsigned int nextTid = 1;
+
+        static TraceState &instance() {
+            static TraceState state;
+            return state;
+        }
+    };
+
+    /** @brief Eventos da thread atual (nulo enquanto a thread não tiver registado nenhum intervalo). */
+    thread_local ThreadEvents *ownEvents = nullptr;
+
+    /**
+     * @brief Eventos da thread atual, registados na primeira utilização.
+     */
+    struct ThreadSlot {
+        ThreadEvents events;
+
+        ThreadSlot() {
+            TraceState &state = TraceState::instance();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            events.tid = state.nextTid++;
+            state.threads.push_back(&events);
+            ownEvents = &events;
+        }
+
+        ~ThreadSlot() {
+            TraceState &state = TraceState::instance();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            ownEvents = nullptr;
+            for (auto it = state.threads.begin(); it != state.threads.end(); it++) {
+                if (*it == &events) {
+                    state.threads.erase(it);
+                    break;
+                }
+            }
+            if (!events.events.empty()) state.retired.push_back(std::move(events));
+        }
+    };
+
+    ThreadEvents &localEvents() {
+        static thread_local ThreadSlot slot;
+        return slot.events;
+    }
+
+    void writeJsonString(std::ostream &out, const std::string &text) {
+        out << '"';
+        for (char c: text) {
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20) out << ' ';
+            else out << c;
+        }
+        out << '"';
+    }
+}
+
+/**
+ * @brief Construtor da classe Span, que marca o início do intervalo.
+ * Complexidade: O(1).
+ * @param name - Nome do intervalo (literal, não é copiado).
+ * @param detail - Informação adicional.
+ */
+Tracer::Span::Span(const char *name, std::string detail)
+        : _name(name), _detail(std::move(detail)), _start(std::chrono::steady_clock::now()), _enabled(isEnabled()) {}
+
+/**
+ * @brief Destrutor da classe Span, que regista o intervalo nos eventos da thread atual. Os eventos de cada thread não
+ * são protegidos por nenhum mutex, por isso Tracer::finish() só pode ser chamado depois de todas as threads que
+ * registam intervalos terem terminado.
+ * Complexidade: O(1) amortizado.
+ */
+Tracer::Span::~Span() {
+    if (!_enabled || !isEnabled()) return;
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point origin = TraceState::instance().origin;
+    localEvents().events.push_back({_name, std::move(_detail),
+                                    std::chrono::duration<double, std::micro>(_start - origin).count(),
+                                    std::chrono::duration<double, std::micro>(end - _start).count()});
+}
+
+/**
+ * @brief Ativa o registo de eventos, que serão escritos no ficheiro indicado em Tracer::finish().
+ * Complexidade: O(1).
+ * @param file - Ficheiro JSON de destino.
+ */
+void Tracer::start(const std::string &file) {
+    TraceState &state = TraceState::instance();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.file = file;
+    state.origin = std::chrono::steady_clock::now();
+    state.enabled.store(true);
+}
+
+/**
+ * @brief Desativa o registo e escreve todos os eventos no ficheiro indicado em Tracer::start().
+ * Pré-condição: todas as outras threads que registaram intervalos já terminaram (join), porque os seus eventos são
+ * lidos sem sincronização; só podem restar os eventos da própria thread, o que é verificado com assert.
+ * Complexidade: O(E), sendo E o número de eventos.
+ * @return Verdadeiro se o ficheiro foi escrito (ou se o registo não estava ativo), falso caso contrário.
+ */
+bool Tracer::finish() {
+    TraceState &state = TraceState::instance();
+    if (!state.enabled.exchange(false)) return true;
+    std::lock_guard<std::mutex> lock(state.mutex);
+    assert(std::all_of(state.threads.begin(), state.threads.end(),
+                       [](const ThreadEvents *events) { return events == ownEvents; }));
+
+    std::vector<ThreadEvents *> all = state.threads;
+    for (ThreadEvents &events: state.retired) all.push_back(&events);
+
+    std::ofstream out(state.file);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    out << "\n{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"project_1_schedule\"}}";
+    out << std::fixed << std::setprecision(3);
+    for (ThreadEvents *events: all) {
+        out << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << events->tid
+            << ", \"args\": {\"name\": \"thread " << events->tid << "\"}}";
+        for (const Event &event: events->events) {
+            out << ",\n{\"name\": ";
+            writeJsonString(out, event.name);
+            out << ", \"cat\": \"schedule\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << events->tid
+                << ", \"ts\": " << event.start << ", \"dur\": " << event.duration;
+            if (!event.detail.empty()) {
+                out << ", \"args\": {\"detail\": ";
+                writeJsonString(out, event.detail);
+                out << "}";
+            }
+            out << "}";
+        }
+        events->events.clear();
+    }
+    out << "\n]}\n";
+    state.retired.clear();
+    return out.good();
+}
+
+/**
+ * @brief Verifica se o registo de eventos está ativo.
+ * Complexidade: O(1).
+ * @return Verdadeiro se estiver ativo, falso caso contrário.
+ */
+bool Tracer::isEnabled() {
+    return TraceState::instance().enabled.load(std::memory_order_relaxed);
+}
+
+#endif
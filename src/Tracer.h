@@ -0,0 +1,61 @@
+#ifndef PROJECT_1_SCHEDULE_TRACER_H
+#define PROJECT_1_SCHEDULE_TRACER_H
+
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "Instrumentation.h"
+
+/**
+ * @brief Classe que regista intervalos de tempo ("spans") no formato trace_event do Chrome, para serem analisados no
+ * Perfetto ou em chrome://tracing. Cada thread guarda os seus eventos e aparece numa linha própria.
+ * Só é compilada quando SCHEDULE_INSTRUMENTATION está definido, e só regista eventos depois de Tracer::start().
+ * Tracer::finish() lê os eventos de todas as threads sem sincronização, pelo que deve ser chamado depois de as threads
+ * de trabalho terem terminado.
+ */
+
+class Tracer {
+public:
+#ifdef SCHEDULE_INSTRUMENTATION
+
+    /**
+     * @brief Intervalo de tempo que é registado quando o objeto é destruído.
+     */
+    class Span {
+    public:
+        explicit Span(const char *name, std::string detail = std::string());
+
+        ~Span();
+
+    private:
+        /** @brief Nome do intervalo. */
+        const char *_name;
+        /** @brief Informação adicional (por exemplo, o aluno e a turma de um pedido). */
+        std::string _detail;
+        /** @brief Instante de início. */
+        std::chrono::steady_clock::time_point _start;
+        /** @brief Indica se o registo estava ativo quando o intervalo começou. */
+        bool _enabled;
+    };
+
+    static void start(const std::string &file);
+
+    static bool finish();
+
+    static bool isEnabled();
+
+#endif
+};
+
+#ifdef SCHEDULE_INSTRUMENTATION
+#define SCHEDULE_TRACE_SPAN(name) Tracer::Span SCHEDULE_CONCAT(_scheduleSpan, __LINE__)(name)
+#define SCHEDULE_TRACE_SPAN_DETAIL(name, detail) \
+    Tracer::Span SCHEDULE_CONCAT(_scheduleSpan, __LINE__)(name, Tracer::isEnabled() ? (detail) : std::string())
+#else
+#define SCHEDULE_TRACE_SPAN(name) ((void) 0)
+#define SCHEDULE_TRACE_SPAN_DETAIL(name, detail) ((void) 0)
+#endif
+
+
+#endif //PROJECT_1_SCHEDULE_TRACER_H
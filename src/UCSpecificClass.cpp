@@ -1,4 +1,42 @@
 #include "UCSpecificClass.h"
+#include "MemoryUsage.h"
+
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Tabela de códigos (de UC ou de turma) e respetivos identificadores compactos.
+     */
+    struct CodeTable {
+        std::vector<std::string> codes;
+        std::unordered_map<std::string, uint16_t> ids;
+
+        uint16_t intern(const std::string &code) {
+            auto it = ids.find(code);
+            if (it != ids.end()) return it->second;
+            if (codes.size() > UINT16_MAX) throw std::length_error("Demasiados códigos distintos para 16 bits: " + code);
+            codes.push_back(code);
+            return ids[code] = uint16_t(codes.size() - 1);
+        }
+
+        [[nodiscard]] int find(const std::string &code) const {
+            auto it = ids.find(code);
+            return it == ids.end() ? -1 : it->second;
+        }
+    };
+
+    CodeTable &ucTable() {
+        static CodeTable table;
+        return table;
+    }
+
+    CodeTable &classTable() {
+        static CodeTable table;
+        return table;
+    }
+}
 
 /**
  * @brief Construtor default da classe UCSpecificClass.
@@ -79,3 +117,66 @@ bool UCSpecificClass::operator>(const UCSpecificClass &rhs) const {
 }
 
 
+
+/**
+ * @brief Estima a memória dinâmica ocupada pelos códigos da turma e da UC.
+ * Complexidade: O(1).
+ * @return Número de bytes.
+ */
+size_t UCSpecificClass::memoryUsage() const {
+    return MemoryUsage::string(_ucCode) + MemoryUsage::string(_classCode);
+}
+
+/**
+ * @brief Permite obter o identificador compacto da turma (UC nos 16 bits mais significativos, turma nos restantes),
+ * registando os códigos que ainda não tenham identificador. Lança std::length_error se um código novo não couber em
+ * 16 bits (mais de 65536 UCs ou turmas distintas), em vez de o confundir com outro.
+ * Complexidade: O(1) em média.
+ * @return Identificador compacto.
+ */
+uint32_t UCSpecificClass::getId() const {
+    return uint32_t(ucTable().intern(_ucCode)) << 16 | classTable().intern(_classCode);
+}
+
+/**
+ * @brief Permite obter o identificador compacto da turma sem registar os códigos (para consultas, por exemplo da turma
+ * de um pedido, que não devem fazer crescer as tabelas de códigos).
+ * Complexidade: O(1) em média.
+ * @return Identificador compacto, ou -1 se o código da UC ou da turma nunca foi registado.
+ */
+int64_t UCSpecificClass::findId() const {
+    int ucId = ucTable().find(_ucCode), classId = classTable().find(_classCode);
+    if (ucId < 0 || classId < 0) return -1;
+    return int64_t(ucId) << 16 | classId;
+}
+
+/**
+ * @brief Permite obter a turma correspondente a um identificador compacto.
+ * Complexidade: O(1).
+ * @param id - Identificador compacto obtido com getId().
+ * @return Turma.
+ */
+UCSpecificClass UCSpecificClass::fromId(uint32_t id) {
+    return {classTable().codes[id & 0xFFFF], ucTable().codes[id >> 16]};
+}
+
+/**
+ * @brief Permite obter o identificador de uma UC sem o registar.
+ * Complexidade: O(1) em média.
+ * @param ucCode - Código da UC.
+ * @return Identificador da UC, ou -1 se o código nunca foi registado.
+ */
+int UCSpecificClass::findUcId(const std::string &ucCode) {
+    return ucTable().find(ucCode);
+}
+
+/**
+ * @brief Permite obter o identificador de uma UC, registando-a se ainda não existir (lança std::length_error se
+ * já houver 65536 UCs).
+ * Complexidade: O(1) em média.
+ * @param ucCode - Código da UC.
+ * @return Identificador da UC.
+ */
+uint16_t UCSpecificClass::internUc(const std::string &ucCode) {
+    return ucTable().intern(ucCode);
+}
@@ -2,10 +2,13 @@
 #define PROJECT_1_SCHEDULE_UCSPECIFICCLASS_H
 
 
+#include <cstdint>
 #include <string>
 
 /**
  * @brief Classe que representa uma identificação especĩfica de uma turma. Não representa uma turma em si, mas sim uma identificação para diferenciar as turmas entre si.
+ * Os códigos de UC e de turma podem ser convertidos em identificadores compactos de 32 bits (16 bits para a UC e 16
+ * para a turma), atribuídos por ordem de aparecimento; ordenar os identificadores agrupa-os por UC.
  */
 
 class UCSpecificClass {
@@ -27,6 +30,26 @@ public:
 
     bool operator>(const UCSpecificClass &rhs) const;
 
+    [[nodiscard]] size_t memoryUsage() const;
+
+    [[nodiscard]] uint32_t getId() const;
+
+    [[nodiscard]] int64_t findId() const;
+
+    static UCSpecificClass fromId(uint32_t id);
+
+    static int findUcId(const std::string &ucCode);
+
+    static uint16_t internUc(const std::string &ucCode);
+
+    /**
+     * @brief Permite obter o identificador da UC contido num identificador compacto de turma.
+     * Complexidade: O(1).
+     * @param id - Identificador compacto da turma.
+     * @return Identificador da UC.
+     */
+    static uint16_t ucIdOf(uint32_t id) { return id >> 16; }
+
 private:
     /** @brief Id de uma UC. */
     std::string _ucCode;
@@ -0,0 +1,245 @@
+#include "UcCatalog.h"
+#include "UCSpecificClass.h"
+#include "FieldParser.h"
+
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+
+namespace {
+    /**
+     * @brief Unidade curricular da tabela interna.
+     */
+    struct BuiltinUc {
+        std::string_view code;
+        std::string_view name;
+        char year;
+        double credits;
+    };
+
+    /** @brief Unidades curriculares da L.EIC. */
+    constexpr std::array<BuiltinUc, 16> BUILTIN_UCS = {{
+            {"UP001", "PUP", '1', 1.5},
+            {"L.EIC001", "ALGA", '1', 6},
+            {"L.EIC002", "AM I", '1', 6},
+            {"L.EIC003", "FP", '1', 6},
+            {"L.EIC004", "FSC", '1', 6},
+            {"L.EIC005", "MD", '1', 6},
+            {"L.EIC011", "AED", '2', 6},
+            {"L.EIC012", "BD", '2', 6},
+            {"L.EIC013", "F II", '2', 6},
+            {"L.EIC014", "LDTS", '2', 6},
+            {"L.EIC015", "SO", '2', 6},
+            {"L.EIC021", "FSI", '3', 6},
+            {"L.EIC022", "IPC", '3', 6},
+            {"L.EIC023", "LBAW", '3', 6},
+            {"L.EIC024", "PFL", '3', 6},
+            {"L.EIC025", "RC", '3', 6}
+    }};
+
+    /** @brief Número de posições da tabela de hash (potência de 2). */
+    constexpr uint32_t BUILTIN_SLOTS = 32;
+
+    /**
+     * @brief Hash FNV-1a de um código, com uma semente.
+     * Complexidade: O(N), sendo N o tamanho do código.
+     * @param code - Código.
+     * @param seed - Semente.
+     * @return Hash do código.
+     */
+    constexpr uint32_t hashCode(std::string_view code, uint32_t seed) {
+        uint32_t hash = 2166136261u ^ seed;
+        for (char c: code) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Procura, em tempo de compilação, a primeira semente para a qual todos os códigos da tabela interna
+     * ficam em posições diferentes (hash perfeita).
+     * @return Semente, ou UINT32_MAX se nenhuma servir.
+     */
+    constexpr uint32_t findSeed() {
+        for (uint32_t seed = 0; seed < 1000; seed++) {
+            bool used[BUILTIN_SLOTS] = {};
+            bool perfect = true;
+            for (const BuiltinUc &uc: BUILTIN_UCS) {
+                uint32_t slot = hashCode(uc.code, seed) % BUILTIN_SLOTS;
+                if (used[slot]) {
+                    perfect = false;
+                    break;
+                }
+                used[slot] = true;
+            }
+            if (perfect) return seed;
+        }
+        return UINT32_MAX;
+    }
+
+    constexpr uint32_t BUILTIN_SEED = findSeed();
+    static_assert(BUILTIN_SEED != UINT32_MAX, "Não existe hash perfeita para a tabela interna de UCs");
+
+    /**
+     * @brief Constrói, em tempo de compilação, a tabela que indica a UC guardada em cada posição.
+     * @return Posição em BUILTIN_UCS da UC de cada posição da tabela de hash, ou -1.
+     */
+    constexpr std::array<int8_t, BUILTIN_SLOTS> buildSlots() {
+        std::array<int8_t, BUILTIN_SLOTS> slots{};
+        for (int8_t &slot: slots) slot = -1;
+        for (size_t i = 0; i < BUILTIN_UCS.size(); i++) {
+            slots[hashCode(BUILTIN_UCS[i].code, BUILTIN_SEED) % BUILTIN_SLOTS] = static_cast<int8_t>(i);
+        }
+        return slots;
+    }
+
+    constexpr std::array<int8_t, BUILTIN_SLOTS> BUILTIN_INDEX = buildSlots();
+
+    /**
+     * @brief Procura uma UC na tabela interna.
+     * Complexidade: O(1).
+     * @param code - Código da UC.
+     * @return Posição da UC em BUILTIN_UCS, ou -1 se não existir.
+     */
+    constexpr int builtinIndex(std::string_view code) {
+        int index = BUILTIN_INDEX[hashCode(code, BUILTIN_SEED) % BUILTIN_SLOTS];
+        return index >= 0 && BUILTIN_UCS[index].code == code ? index : -1;
+    }
+
+    static_assert(builtinIndex("L.EIC011") == 6 && builtinIndex("L.EIC099") == -1);
+}
+
+/**
+ * @brief Construtor default da classe UcCatalog. O catálogo começa vazio e deve ser carregado no arranque, depois das
+ * turmas, para que os identificadores das UCs continuem a ser atribuídos pela ordem do ficheiro das turmas.
+ * Complexidade: O(1).
+ */
+UcCatalog::UcCatalog() = default;
+
+/**
+ * @brief Substitui o catálogo pelas UCs de um ficheiro CSV (UcCode,UcName,Year,Credits).
+ * Se o ficheiro não existir, o catálogo não é alterado. As linhas cujo ano não tem exatamente um carácter ou cujos
+ * créditos não são um número não negativo são ignoradas e contadas.
+ * Complexidade: O(N).
+ * @param file - Ficheiro.
+ * @return Verdadeiro se o ficheiro foi lido, falso caso contrário.
+ */
+bool UcCatalog::load(const std::string &file) {
+    std::ifstream arquivo(file);
+    if (!arquivo.is_open()) return false;
+    std::string linha;
+    std::getline(arquivo, linha);
+
+    std::vector<UcInfo> ucs;
+    unsigned int invalid = 0;
+    while (std::getline(arquivo, linha)) {
+        if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+        std::stringstream linhaStream(linha);
+        std::string code, name, year, credits;
+        if (!(std::getline(linhaStream, code, ',')
+              && std::getline(linhaStream, name, ',')
+              && std::getline(linhaStream, year, ',')
+              && std::getline(linhaStream, credits, ','))) {
+            continue;
+        }
+        double value;
+        if (year.size() != 1 || !FieldParser::parseDouble(credits, value) || value < 0) {
+            invalid++;
+            continue;
+        }
+        ucs.push_back({code, name, year[0], value});
+    }
+    if (invalid > 0) std::cerr << invalid << " linhas com ano ou créditos inválidos ignoradas em " << file << std::endl;
+    _ucs = std::move(ucs);
+    _builtin = false;
+    index();
+    return true;
+}
+
+/**
+ * @brief Substitui o catálogo pela tabela interna.
+ * Complexidade: O(N).
+ */
+void UcCatalog::loadBuiltin() {
+    _ucs.clear();
+    for (const BuiltinUc &uc: BUILTIN_UCS) {
+        _ucs.push_back({std::string(uc.code), std::string(uc.name), uc.year, uc.credits});
+    }
+    _builtin = true;
+    index();
+}
+
+/**
+ * @brief Regista as UCs do catálogo nos identificadores compactos e constrói os índices por identificador e por ano.
+ * Complexidade: O(N).
+ */
+void UcCatalog::index() {
+    _byUcId.clear();
+    _ucsOfYear.clear();
+    for (size_t i = 0; i < _ucs.size(); i++) {
+        uint16_t id = UCSpecificClass::internUc(_ucs[i].code);
+        if (_byUcId.size() <= id) _byUcId.resize(id + 1, -1);
+        _byUcId[id] = static_cast<int32_t>(i);
+        _ucsOfYear[_ucs[i].year].push_back(_ucs[i].code);
+    }
+}
+
+/**
+ * @brief Procura uma UC pelo código. Com a tabela interna usa a hash perfeita; caso contrário usa o identificador
+ * compacto da UC.
+ * Complexidade: O(1) em média.
+ * @param ucCode - Código da UC.
+ * @return Informação da UC, ou nullptr se não pertencer ao catálogo.
+ */
+const UcInfo *UcCatalog::find(const std::string &ucCode) const {
+    if (_builtin) {
+        int index = builtinIndex(ucCode);
+        return index < 0 ? nullptr : &_ucs[index];
+    }
+    int id = UCSpecificClass::findUcId(ucCode);
+    return id < 0 ? nullptr : findById(id);
+}
+
+/**
+ * @brief Procura uma UC pelo identificador compacto.
+ * Complexidade: O(1).
+ * @param ucId - Identificador da UC (ver UCSpecificClass::getId()).
+ * @return Informação da UC, ou nullptr se não pertencer ao catálogo.
+ */
+const UcInfo *UcCatalog::findById(uint16_t ucId) const {
+    if (ucId >= _byUcId.size() || _byUcId[ucId] < 0) return nullptr;
+    return &_ucs[_byUcId[ucId]];
+}
+
+/**
+ * @brief Permite obter os códigos das UCs de um ano.
+ * Complexidade: O(log Y), sendo Y o número de anos.
+ * @param year - Ano ('1', '2', ...).
+ * @return Códigos das UCs, pela ordem do catálogo (vazio se o ano não existir).
+ */
+const std::vector<std::string> &UcCatalog::ucsOfYear(char year) const {
+    static const std::vector<std::string> none;
+    auto it = _ucsOfYear.find(year);
+    return it == _ucsOfYear.end() ? none : it->second;
+}
+
+/**
+ * @brief Permite obter todas as UCs do catálogo.
+ * Complexidade: O(1).
+ * @return UCs, pela ordem do catálogo.
+ */
+const std::vector<UcInfo> &UcCatalog::getUcs() const {
+    return _ucs;
+}
+
+/**
+ * @brief Indica se o catálogo é a tabela interna.
+ * Complexidade: O(1).
+ * @return Verdadeiro se for a tabela interna, falso se foi lido de um ficheiro.
+ */
+bool UcCatalog::isBuiltin() const {
+    return _builtin;
+}
@@ -0,0 +1,65 @@
+#ifndef PROJECT_1_SCHEDULE_UCCATALOG_H
+#define PROJECT_1_SCHEDULE_UCCATALOG_H
+
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Informação sobre uma unidade curricular.
+ */
+
+struct UcInfo {
+    /** @brief Código da UC. */
+    std::string code;
+    /** @brief Nome (abreviado) da UC. */
+    std::string name;
+    /** @brief Ano do curso em que a UC é lecionada ('1', '2', ...). */
+    char year;
+    /** @brief Créditos ECTS. */
+    double credits;
+};
+
+/**
+ * @brief Catálogo das unidades curriculares, construído uma vez no arranque a partir de um ficheiro ucs.csv
+ * (UcCode,UcName,Year,Credits) ou, na falta deste, das UCs da L.EIC, guardadas numa tabela constexpr com uma função de
+ * hash perfeita calculada em tempo de compilação.
+ * Cada UC do catálogo é registada nos identificadores compactos de UCSpecificClass, e um vetor indexado por esse
+ * identificador dá acesso direto à informação da UC.
+ */
+
+class UcCatalog {
+public:
+    UcCatalog();
+
+    bool load(const std::string &file);
+
+    void loadBuiltin();
+
+    [[nodiscard]] const UcInfo *find(const std::string &ucCode) const;
+
+    [[nodiscard]] const UcInfo *findById(uint16_t ucId) const;
+
+    [[nodiscard]] const std::vector<std::string> &ucsOfYear(char year) const;
+
+    [[nodiscard]] const std::vector<UcInfo> &getUcs() const;
+
+    [[nodiscard]] bool isBuiltin() const;
+
+private:
+    /** @brief Unidades curriculares, pela ordem do ficheiro (ou da tabela interna). */
+    std::vector<UcInfo> _ucs;
+    /** @brief Posição em _ucs de cada identificador de UC, ou -1 se a UC não pertence ao catálogo. */
+    std::vector<int32_t> _byUcId;
+    /** @brief Códigos das UCs de cada ano, pela ordem do catálogo. */
+    std::map<char, std::vector<std::string>> _ucsOfYear;
+    /** @brief Indica se o catálogo é a tabela interna. */
+    bool _builtin = false;
+
+    void index();
+};
+
+
+#endif //PROJECT_1_SCHEDULE_UCCATALOG_H
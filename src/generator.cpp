@@ -0,0 +1,48 @@
+#include <iostream>
+#include <string>
+#include "DatasetGenerator.h"
+#include "FieldParser.h"
+
+int main(int argc, char *argv[]) {
+    GeneratorConfig config;
+    std::string outputDir;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (i + 1 >= argc) {
+            outputDir.clear();
+            break;
+        }
+        std::string value = argv[++i];
+        unsigned int *field = nullptr;
+        if (option == "--out") {
+            outputDir = value;
+            continue;
+        } else if (option == "--years") field = &config.years;
+        else if (option == "--ucs") field = &config.ucsPerYear;
+        else if (option == "--classes") field = &config.classesPerUc;
+        else if (option == "--lessons") field = &config.lessonsPerClass;
+        else if (option == "--students") field = &config.students;
+        else if (option == "--requests") field = &config.requests;
+        else if (option == "--seed") field = &config.seed;
+        if (field == nullptr || !FieldParser::parseUnsigned(value, *field)) {
+            outputDir.clear();
+            break;
+        }
+    }
+    if (outputDir.empty() || config.years == 0 || config.ucsPerYear == 0 || config.classesPerUc == 0) {
+        std::cerr << "Utilização: schedule_generator --out <pasta> [--years N] [--ucs N] [--classes N] [--lessons N]"
+                  << " [--students N] [--requests N] [--seed N]" << std::endl;
+        return 1;
+    }
+
+    DatasetGenerator generator(config);
+    if (!generator.generate(outputDir)) {
+        std::cerr << "Não foi possível escrever os ficheiros em " << outputDir << std::endl;
+        return 1;
+    }
+    std::cout << "Dados gerados em " << outputDir << ": " << config.students << " alunos, "
+              << config.years * config.ucsPerYear << " unidades curriculares, "
+              << config.years * config.ucsPerYear * config.classesPerUc << " turmas e "
+              << config.requests << " pedidos." << std::endl;
+    return 0;
+}
@@ -1,10 +1,10 @@
-
-
 #include "Interface.h"
 
-int main() {
+int main(int argc, char *argv[]) {
+    if (argc > 1) {
+        return Interface::runBatch(std::vector<std::string>(argv + 1, argv + argc));
+    }
     Interface interface;
     Interface::run();
     return 0;
 }
-